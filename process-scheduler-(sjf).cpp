@@ -1,7 +1,7 @@
 //Tim Garvin
 
-//Compile using: g++ -std=c++0x 'process-scheduler-(sjf).cpp' -o 'process-scheduler-(sjf)'
-//Execute using: ./'process-scheduler-(sjf)'
+//Compile using: g++ -std=c++0x -O2 -pthread 'process-scheduler-(sjf).cpp' -o 'process-scheduler-(sjf)'
+//Execute using: ./'process-scheduler-(sjf)' [trace|batch|cluster|timeline|energy|deadline|fuzz] [--option=value ...] (run with --help to list the options)
 
 /*Description: This C++11 program simulates the scheduling of a set of k processes using the Shortest Job First (SJF) scheduling algorithm (the optimal algorithm choice for minimizing process waiting times). In this 
 			case, k = 50, but this program is also generalized enough to allow user input to define k instead. All that would be needed is the implementation of a user prompt. Each "process" is generated in a Doubly 
@@ -18,6 +18,19 @@
 #include <algorithm> //Required for sort() library function
 #include <vector> //Required for using vectors
 #include <fstream> //Required for file input/output
+#include <queue> //Required for priority_queue
+#include <string> //Required for comparing command-line arguments
+#include <cstdlib> //Required for strtod() and strtoll()
+#include <climits> //Required for LLONG_MAX, INT_MAX, and UINT_MAX
+#include <cmath> //Required for sqrt() and ceil()
+#include <chrono> //Required for timing the cluster simulation
+#include <deque> //Required for the Highest Response Ratio Next buckets
+#include <map> //Required for storing command-line options
+#include <thread> //Required for running batch configurations in parallel
+#include <atomic> //Required for handing out batch configurations to threads
+#include <functional> //Required for passing tasks to threads
+#include <cstring> //Required for memcpy()
+#include <sstream> //Required for reading trace files
 
 using namespace std;
 
@@ -27,34 +40,166 @@ struct node
 	int process_ID;
 	int CPU_cycles;
 	int memory_footprint;
-	int arrival_time;
-	int start_time;
-	int stop_time;
-	int current_time;
-	int previous_end_time;
-	int waiting_time;
+	long long arrival_time;
+	long long deadline; //Time the process should finish by (NO_DEADLINE if it has no deadline)
+	long long start_time;
+	long long stop_time;
+	long long current_time;
+	long long previous_end_time;
+	long long waiting_time;
 	int remaining_cycles;
+	int processor; //Index of the processor the process executed on (set by schedule_processes)
 	
 	node *next_node;
 	node *prev_node;
 };
 
+const long long NO_DEADLINE = LLONG_MAX; //Deadline of a process that has no deadline
+
+//Compact copy of a process that is stored by value in a process queue (keeps very large runs from needing a node for every process)
+struct ready_job
+{
+	int process_ID;
+	int CPU_cycles;
+	long long arrival_time;
+	long long deadline;
+};
+
 vector<node*> process_list; //Keeps an original, unchanged copy of the Doubly Linked List of processes
 vector<node*> process_queue; //Used to queue processes for execution
 
-int total_cycles = 0; //Keeps track of the total number of cycles amongst the whole set of processes
+long long total_cycles = 0; //Keeps track of the total number of cycles amongst the whole set of processes
 
-vector<node*> processor1_schedule; //Keeps track of the schedule for processor 1 in a multi-processor system
-vector<node*> processor2_schedule; //Keeps track of the schedule for processor 2 in a multi-processor system
-vector<node*> processor3_schedule; //Keeps track of the schedule for processor 3 in a multi-processor system
-vector<node*> processor4_schedule; //Keeps track of the schedule for processor 4 in a multi-processor system
+vector< vector<node*> > processor_schedules; //Keeps track of the schedule for each processor in a multi-processor system
 
-//Generates the number of processes specified by the user
-node *generate_processes(node *head, int num_processes)
+string output_prefix = ""; //Added to the front of every output file name (can be a directory, such as "results/")
+
+//Generates a random number of CPU cycles between 1,000 - 11,000 for a process using the Normal Distribution for CPU cycles
+int generate_cycles(mt19937 &randomNum_generator, normal_distribution<> &cycles_distribution)
 {
-	node *current_node = head;
-	node *previous_node = head;
+	int cycles = cycles_distribution(randomNum_generator); //Generates a random number for the number of CPU cycles
+	
+	//Checks if the currently generated random number for CPU cycles is between 1,000 - 11,000
+	//If not between 1,000 - 11,000: Loop until a random number is generated that is
+	while(cycles < 1000 || cycles > 11000)
+	{
+		cycles = cycles_distribution(randomNum_generator);
+	}
+	
+	return cycles;
+}
+
+//Arrival processes used to space out the arrival times of processes
+enum arrival_model
+{
+	ARRIVAL_FIXED, //Every process arrives a fixed number of cycles after the previous one
+	ARRIVAL_POISSON, //Poisson process: exponentially distributed gaps between arrivals
+	ARRIVAL_MMPP, //Markov-Modulated Poisson Process: switches between a calm state and a bursty state with a higher arrival rate
+	ARRIVAL_DIURNAL //Poisson process whose arrival rate rises and falls in a sine wave (a daily cycle)
+};
+
+//Distributions used for the number of CPU cycles (burst length) of each process
+enum burst_model
+{
+	BURST_NORMAL, //Normal distribution truncated to 1,000 - 11,000 cycles
+	BURST_PARETO //Heavy-tailed Pareto distribution truncated to pareto_min_cycles - pareto_max_cycles
+};
+
+//Settings for generating a workload of processes
+struct workload_config
+{
+	arrival_model arrivals;
+	burst_model bursts;
+	double arrival_spacing; //Average number of cycles between arrivals (used when load_factor is 0)
+	double load_factor; //Target utilization (rho) of processor_count processors: when greater than 0, sets the arrival rate automatically
+	int processor_count; //Number of processors the load factor is measured against
+	double pareto_shape; //Shape (alpha) of the Pareto distribution (smaller values give a heavier tail)
+	int pareto_min_cycles; //Smallest burst length for the Pareto distribution
+	int pareto_max_cycles; //Largest burst length for the Pareto distribution
+	double mmpp_rate_ratio; //Arrival rate in the bursty state divided by the arrival rate in the calm state
+	double mmpp_burst_fraction; //Fraction of time spent in the bursty state
+	double mmpp_burst_length; //Average length of a bursty period, measured in average gaps between arrivals
+	double diurnal_amplitude; //How far the diurnal arrival rate swings above and below its average (0 - 1)
+	double diurnal_period; //Length of one diurnal cycle, measured in average gaps between arrivals
+	double deadline_fraction; //Fraction of processes with an SLA deadline (0 - 1)
+	double deadline_min_stretch; //A process' deadline is its arrival time plus between deadline_min_stretch and deadline_max_stretch times its CPU cycles
+	double deadline_max_stretch;
+	unsigned int seed; //Seed for the random number generator
+};
+
+//Sets a workload to the original settings: Normal Distribution CPU cycles with a process arriving every 50 cycles
+void default_workload(workload_config &workload)
+{
+	workload.arrivals = ARRIVAL_FIXED;
+	workload.bursts = BURST_NORMAL;
+	workload.arrival_spacing = 50;
+	workload.load_factor = 0;
+	workload.processor_count = 1;
+	workload.pareto_shape = 1.5;
+	workload.pareto_min_cycles = 1000;
+	workload.pareto_max_cycles = 1000000;
+	workload.mmpp_rate_ratio = 10;
+	workload.mmpp_burst_fraction = 0.1;
+	workload.mmpp_burst_length = 100;
+	workload.diurnal_amplitude = 0.8;
+	workload.diurnal_period = 1000;
+	workload.deadline_fraction = 0;
+	workload.deadline_min_stretch = 2;
+	workload.deadline_max_stretch = 6;
+	workload.seed = random_device()();
+}
+
+//State for generating processes one at a time, so very large workloads can be streamed instead of stored
+struct workload_generator
+{
+	workload_config config;
+	mt19937 randomNum_generator;
+	mt19937 deadline_generator; //Separate random number generator for deadlines, so turning deadlines on does not change the other values of a seed
+	normal_distribution<> cycles_distribution;
+	normal_distribution<> footprints_distribution;
+	uniform_real_distribution<> uniform_distribution; //Uniform random numbers in [0, 1)
+	double mean_spacing; //Average number of cycles between arrivals
+	double arrival_clock; //Arrival time of the most recent process (kept as a fraction so rounding does not drift)
+	long long generated; //Number of arrival times generated so far
+	bool bursty; //Whether the MMPP is currently in its bursty state
+	double state_end; //Time the current MMPP state ends
+};
+
+//Returns the average CPU cycles of a process for a workload's burst model (the truncated Normal Distribution is symmetric around 6,000)
+double mean_burst_cycles(const workload_config &config)
+{
+	if(config.bursts == BURST_PARETO)
+	{
+		//Bounded Pareto mean = L^a / (1 - (L/H)^a) * a / (a - 1) * (1/L^(a-1) - 1/H^(a-1)) (for L = min cycles, H = max cycles, a = shape)
+		double low = config.pareto_min_cycles, high = config.pareto_max_cycles, shape = config.pareto_shape;
+		
+		return pow(low, shape) / (1 - pow(low / high, shape)) * shape / (shape - 1) * (1 / pow(low, shape - 1) - 1 / pow(high, shape - 1));
+	}
+	
+	return 6000;
+}
+
+//Returns the average number of cycles between arrivals for a workload
+//Load factor (rho) = arrival rate * average CPU cycles / processors, so the average gap between arrivals = average CPU cycles / (rho * processors)
+double mean_arrival_spacing(const workload_config &config)
+{
+	if(config.load_factor > 0)
+	{
+		return mean_burst_cycles(config) / (config.load_factor * config.processor_count);
+	}
 	
+	return config.arrival_spacing;
+}
+
+//Returns an exponentially distributed random number with the given mean
+double generate_exponential(workload_generator &generator, double mean)
+{
+	return -log(1 - generator.uniform_distribution(generator.randomNum_generator)) * mean;
+}
+
+//Initializes a workload generator and calculates the arrival rate (from the load factor, if one is set)
+void init_workload_generator(workload_generator &generator, const workload_config &config)
+{
 	//For standard normal distribution: About 99.7% will be within +-3 standard deviations
 	//So choose the correct standard deviation using: Standard Deviation = Midpoint/3 (where Midpoint = (lower bound + upper bound)/2
 	
@@ -64,70 +209,251 @@ node *generate_processes(node *head, int num_processes)
 	//Memory Footprints midpoint = (1 + 100)/2 = 50.50
 	//Standard Deviation (memory footprints) = 50.5/3 = 16.8333 = 101/6
 	
-	//Declares variables for random number generation
-	random_device rd;
-	mt19937 randomNum_generator(rd());
+	generator.config = config;
+	generator.randomNum_generator.seed(config.seed);
+	generator.deadline_generator.seed(config.seed + 2); //The cluster dispatcher uses seed + 1
 	
 	//Declares variables used to generate a random number using Normal Distribution for the number of CPU cycles and memory footprints for each process
 	//normal_distribution<type> distribution(mean, standard deviation);
-	normal_distribution<> cycles_distribution(6000, 2000);
-	normal_distribution<> footprints_distribution(20, 101/6);
+	generator.cycles_distribution = normal_distribution<>(6000, 2000);
+	generator.footprints_distribution = normal_distribution<>(20, 101/6);
+	generator.uniform_distribution = uniform_real_distribution<>(0, 1);
+	
+	generator.mean_spacing = mean_arrival_spacing(config);
+	
+	generator.arrival_clock = 0;
+	generator.generated = 0;
+	generator.bursty = false;
+	generator.state_end = 0;
+	
+	if(config.arrivals == ARRIVAL_MMPP)
+	{
+		generator.state_end = generate_exponential(generator, config.mmpp_burst_length * generator.mean_spacing * (1 - config.mmpp_burst_fraction) / config.mmpp_burst_fraction);
+	}
+}
+
+//Generates the number of CPU cycles for the next process using the workload's burst model
+int generate_burst(workload_generator &generator)
+{
+	if(generator.config.bursts == BURST_PARETO)
+	{
+		//Inverse of the bounded Pareto CDF: x = L / (1 - u * (1 - (L/H)^a))^(1/a)
+		double low = generator.config.pareto_min_cycles, high = generator.config.pareto_max_cycles, shape = generator.config.pareto_shape;
+		double u = generator.uniform_distribution(generator.randomNum_generator);
+		
+		return (int)min(high, low / pow(1 - u * (1 - pow(low / high, shape)), 1 / shape));
+	}
+	
+	return generate_cycles(generator.randomNum_generator, generator.cycles_distribution);
+}
+
+//Generates a random memory footprint between 1 - 100 for the next process using the Normal Distribution for memory footprints
+int generate_footprint(workload_generator &generator)
+{
+	int footprint = generator.footprints_distribution(generator.randomNum_generator);
+	
+	//Checks if the currently generated random number for the memory footprint is between 1 - 100
+	//If not between 1 - 100: Loop until a random number is generated that is
+	while(footprint < 1 || footprint > 100)
+	{
+		footprint = generator.footprints_distribution(generator.randomNum_generator);
+	}
+	
+	return footprint;
+}
+
+//Generates the relative deadline (time allowed from arrival to finish) for a process with the given CPU cycles
+//Returns NO_DEADLINE for the processes that do not get a deadline (1 - deadline_fraction of them)
+long long generate_deadline(workload_generator &generator, int CPU_cycles)
+{
+	const workload_config &config = generator.config;
+	
+	double u = generator.uniform_distribution(generator.deadline_generator);
+	double stretch = config.deadline_min_stretch + generator.uniform_distribution(generator.deadline_generator) * (config.deadline_max_stretch - config.deadline_min_stretch);
+	
+	if(u >= config.deadline_fraction)
+	{
+		return NO_DEADLINE;
+	}
+	
+	return (long long)ceil(stretch * CPU_cycles);
+}
+
+//Generates the arrival time of the next process using the workload's arrival model (the first process arrives at time 0)
+long long generate_arrival(workload_generator &generator)
+{
+	const workload_config &config = generator.config;
+	double &clock = generator.arrival_clock;
+	
+	//If the average gap between arrivals is 0: Every process arrives at time 0 (MMPP and diurnal would otherwise loop forever on gaps and periods of 0)
+	if(generator.generated > 0 && generator.mean_spacing > 0)
+	{
+		switch(config.arrivals)
+		{
+			case ARRIVAL_FIXED:
+			{
+				clock += generator.mean_spacing;
+				break;
+			}
+			case ARRIVAL_POISSON:
+			{
+				clock += generate_exponential(generator, generator.mean_spacing);
+				break;
+			}
+			case ARRIVAL_MMPP:
+			{
+				//Rates are chosen so the time-weighted average rate matches the average gap: (1 - f) * calm rate + f * ratio * calm rate = 1 / mean_spacing
+				double calm_spacing = generator.mean_spacing * ((1 - config.mmpp_burst_fraction) + config.mmpp_burst_fraction * config.mmpp_rate_ratio);
+				double burst_length = config.mmpp_burst_length * generator.mean_spacing;
+				double calm_length = burst_length * (1 - config.mmpp_burst_fraction) / config.mmpp_burst_fraction;
+				
+				//Loop until an arrival lands inside the current state (gaps are memoryless, so a gap that crosses into the next state is redrawn there)
+				while(true)
+				{
+					double gap = generate_exponential(generator, generator.bursty ? calm_spacing / config.mmpp_rate_ratio : calm_spacing);
+					
+					if(clock + gap < generator.state_end)
+					{
+						clock += gap;
+						break;
+					}
+					
+					clock = generator.state_end;
+					generator.bursty = !generator.bursty;
+					generator.state_end = clock + generate_exponential(generator, generator.bursty ? burst_length : calm_length);
+				}
+				
+				break;
+			}
+			case ARRIVAL_DIURNAL:
+			{
+				//Thinning: draws arrivals at the peak rate and keeps each one with probability (rate at that time) / (peak rate)
+				double period = config.diurnal_period * generator.mean_spacing;
+				double peak = 1 + config.diurnal_amplitude;
+				
+				while(true)
+				{
+					clock += generate_exponential(generator, generator.mean_spacing / peak);
+					
+					double rate = 1 + config.diurnal_amplitude * sin(2 * 3.14159265358979323846 * clock / period);
+					
+					if(generator.uniform_distribution(generator.randomNum_generator) * peak < rate)
+					{
+						break;
+					}
+				}
+				
+				break;
+			}
+		}
+	}
+	
+	generator.generated++;
+	
+	return (long long)clock;
+}
+
+//Returns the name of an arrival model (used for output)
+string arrival_model_name(arrival_model arrivals)
+{
+	switch(arrivals)
+	{
+		case ARRIVAL_FIXED:
+			return "Fixed";
+		case ARRIVAL_POISSON:
+			return "Poisson";
+		case ARRIVAL_MMPP:
+			return "MMPP";
+		default:
+			return "Diurnal";
+	}
+}
+
+//Finds the arrival model for a name (fixed, poisson, mmpp, or diurnal), returns false if the name is not an arrival model
+bool parse_arrival_model(const string &name, arrival_model &arrivals)
+{
+	const arrival_model models[4] = {ARRIVAL_FIXED, ARRIVAL_POISSON, ARRIVAL_MMPP, ARRIVAL_DIURNAL};
+	const string names[4] = {"fixed", "poisson", "mmpp", "diurnal"};
+	
+	for(int index = 0; index < 4; index++)
+	{
+		if(name == names[index])
+		{
+			arrivals = models[index];
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+//Generates the number of processes specified by the user, using the workload's arrival and burst models
+//If a trace was read (trace is not empty): The processes' CPU cycles, arrival times, and deadlines come from the trace instead (memory footprints are still generated)
+node *generate_processes(node *head, int num_processes, const workload_config &workload, const vector<ready_job> &trace)
+{
+	node *current_node = head;
+	node *previous_node = head;
+	
+	//Declares and initializes the generator for the random CPU cycles, memory footprints, and arrival times of each process
+	workload_generator generator;
+	init_workload_generator(generator, workload);
 	
 	//Declares and initializes variables to store the currently returned random number from the Normal Distribution random number generator for number of CPU cycles and memory footprints for each process
 	int cycles = 0, footprint = 0;
 	
-	int arrival = 0; //Used to store and increment arrival time for each process
+	bool show_deadlines = (workload.deadline_fraction > 0 || !trace.empty()); //Only adds the deadline column when processes can have deadlines
 	
 	//Prints headers for output
 	cout<<endl;
-	cout<<"Generated Processes: "<<endl<<endl;
+	cout<<(trace.empty() ? "Generated Processes: " : "Processes (from trace): ")<<endl<<endl;
 	cout<<"Process ID\t"
 	   <<"Cycles\t"
 	   <<"Memory Footprint\t"
 	   <<"Arrival Time\t"
-	   <<"Remaining Time"<<endl;
-	cout<<"------------------------------------------------------------------------------"<<endl;
+	   <<"Remaining Time"<<(show_deadlines ? "\tDeadline" : "")<<endl;
+	cout<<"------------------------------------------------------------------------------"<<(show_deadlines ? "----------------" : "")<<endl;
 	
 	//Loop used to generate the number of processes in the Doubly Linked List that the user requests
 	for(int i=0; i < num_processes; i++)
 	{
 		current_node->process_ID = i+1; //Sets the current process' process ID
 		
-		cycles = cycles_distribution(randomNum_generator); //Generates a random number for the number of CPU cycles for the current process
+		cycles = trace.empty() ? generate_burst(generator) : trace[i].CPU_cycles; //Generates a random number for the number of CPU cycles for the current process
 		
-		//Checks if the currently generated random number for CPU cycles is between 1,000 - 11,000
-		//If not between 1,000 - 11,000: Loop until a random number is generated that is
-		while(cycles < 1000 || cycles > 11000)
-		{
-			cycles = cycles_distribution(randomNum_generator);
-		}
+		footprint = generate_footprint(generator); //Generates a random number for the memory footprint for the current process
 		
-		footprint = footprints_distribution(randomNum_generator); //Generates a random number for the memory footprint for the current process
+		//Stores the number of CPU cycles, memory footprint, arrival time, and deadline values generated for the current process
+		current_node->CPU_cycles = cycles;
+		current_node->memory_footprint = footprint;
+		current_node->arrival_time = trace.empty() ? generate_arrival(generator) : trace[i].arrival_time;
+		current_node->deadline = trace.empty() ? generate_deadline(generator, cycles) : trace[i].deadline;
 		
-		//Checks if the currently generated random number for the memory footprint is between 1 - 100
-		//If not between 1 - 100: Loop until a random number is generated that is
-		while(footprint < 1 || footprint > 100)
+		if(trace.empty() && current_node->deadline != NO_DEADLINE)
 		{
-			footprint = footprints_distribution(randomNum_generator);
+			current_node->deadline += current_node->arrival_time;
 		}
 		
-		//Stores the number of CPU cycles, memory footprint, and arrival time values generated for the current process
-		current_node->CPU_cycles = cycles;
-		current_node->memory_footprint = footprint;
-		current_node->arrival_time = arrival;
 		current_node->start_time = 0;
 		current_node->stop_time = 0;
 		current_node->current_time = 0;
 		current_node->previous_end_time = 0;
 		current_node->waiting_time = 0;
 		current_node->remaining_cycles = cycles;
+		current_node->processor = 0;
 		
 		//Prints the currently generated process' information
 		cout<<setw(10)<<left<<"p" + to_string( current_node->process_ID )<<"\t"
 			<<setw(6)<<right<<current_node->CPU_cycles<<"\t"
 			<<setw(16)<<current_node->memory_footprint<<"\t"
 			<<setw(12)<<current_node->arrival_time<<"\t"
-			<<setw(14)<<current_node->remaining_cycles<<endl;
+			<<setw(14)<<current_node->remaining_cycles;
+		
+		if(show_deadlines)
+		{
+			cout<<"\t"<<setw(8)<<((current_node->deadline == NO_DEADLINE) ? "-" : to_string(current_node->deadline));
+		}
+		
+		cout<<endl;
 		
 		//If not the first process generated: set the previous node value for the current process and move the previous_node pointer to the current node for the next process before iterating
 		if(i > 0)
@@ -136,7 +462,6 @@ node *generate_processes(node *head, int num_processes)
 			previous_node = current_node;
 		}
 		
-		arrival += 50; //Increments the arrival time
 		total_cycles += current_node->CPU_cycles;
 		
 		process_list[i] = current_node;
@@ -147,6 +472,10 @@ node *generate_processes(node *head, int num_processes)
 			current_node->next_node = new node;
 			current_node = current_node->next_node;
 		}
+		else
+		{
+			current_node->next_node = nullptr;
+		}
 	}
 	
 	cout<<endl<<endl;
@@ -167,6 +496,7 @@ void reset_processes(node *head, int num_processes)
 		current_node->previous_end_time = 0;
 		current_node->waiting_time = 0;
 		current_node->remaining_cycles = current_node->CPU_cycles;
+		current_node->processor = 0;
 		
 		current_node = current_node->next_node;
 	}
@@ -174,652 +504,3413 @@ void reset_processes(node *head, int num_processes)
 	delete current_node; //Deletes the current_node pointer
 	
 	//Clears out all of the processor schedules and the process queue
-	processor1_schedule.clear();
-	processor2_schedule.clear();
-	processor3_schedule.clear();
-	processor4_schedule.clear();
+	processor_schedules.clear();
 	process_queue.clear();
 }
 
-//Runs the Shortest Job First scheduling algorithm for the set of processes in a single processor system
-void SJF_single_processor(node *head, int num_processes)
+//Orders ready jobs so the shortest job is on top of a priority_queue (ties go to the earlier arrival, then to the lower process ID)
+struct shortest_job_first
 {
-	ofstream sjf_file("SJF Output (single processor).txt"); //Declares an output file stream for Shortest Job First scheduling output
-
-	//Runs the Shortest Job First scheduling algorithm for processes if the file has been opened without errors
-	if (sjf_file.is_open())
+	bool operator()(const ready_job &a, const ready_job &b) const
 	{
+		if(a.CPU_cycles != b.CPU_cycles)
+		{
+			return a.CPU_cycles > b.CPU_cycles;
+		}
 		
-		process_queue = process_list; //Initializes the process queue to the process list (contains the whole Doubly Linked List of processes)
-		
-		//Sorts the process queue in ascending cycles order
-		sort(process_queue.begin(), process_queue.end(), [](const node *a, const node *b) { 
-			return a->CPU_cycles < b->CPU_cycles;
-		});
-		
-		//Prints headers for output
-		sjf_file<<"SJF (Shortest Job First) Schedule (Single Processor System):"<<endl<<endl;
-		sjf_file<<"Process Order\t"
-				<<"Cycles\t"
-				<<"Memory Footprint\t"
-				<<"Arrival Time\t"
-				<<"Start Time\t"
-				<<"Stop Time\t"
-				<<"Waiting Time"<<endl;
-		sjf_file<<"------------------------------------------------------------------------------------------------"<<endl;
-		
-		int current_time = 0, waiting_time = 0, total_waiting_time = 0;
-		int i = 0;	
-		
-		//Loop through the process queue to execute each process until the process queue is empty
-		while( !process_queue.empty() )
+		if(a.arrival_time != b.arrival_time)
 		{
-			//If the arrival time for the current process has arrived: Execute the current process
-			//Else: Check the next process in queue
-			if(process_queue[i]->arrival_time <= current_time)
-			{
-				//Calculates the waiting time for the current process and increments it to the total waiting time overall
-				waiting_time = current_time - process_queue[i]->arrival_time;
-				total_waiting_time += waiting_time;
-				
-				//Prints the currently executing process' information
-				sjf_file<<setw(13)<<left<<"p" + to_string( process_queue[i]->process_ID )<<"\t"
-						<<setw(6)<<right<<process_queue[i]->CPU_cycles<<"\t"
-						<<setw(16)<<process_queue[i]->memory_footprint<<"\t"
-						<<setw(12)<<process_queue[i]->arrival_time<<"\t"
-						<<setw(10)<<current_time<<"\t"; //Prints out the start time
-				
-				current_time += process_queue[i]->CPU_cycles; //Increments the current time to the stop time for the currently executing process
-				
-				sjf_file<<setw(10)<<current_time<<"\t" //Prints out the stop time
-						<<setw(12)<<waiting_time<<endl;
-				
-				process_queue.erase(process_queue.begin()+i); //Removes the completely executed process from the process queue
-				
-				i = 0; //Goes back to the beginning of the process queue
-			}
-			else
-			{
-				i++; //Goes to the next process in the process queue
-			}
+			return a.arrival_time > b.arrival_time;
 		}
 		
-		sjf_file<<endl;
+		return a.process_ID > b.process_ID;
+	}
+};
+
+//Returns the given percentile (0 - 100) of a set of values using the nearest-rank method (reorders the values while searching)
+long long percentile(vector<long long> &values, double percent)
+{
+	if(values.empty())
+	{
+		return 0;
+	}
 	
-		double avg_waiting_time = 0;
-		
-		avg_waiting_time = total_waiting_time / num_processes;
-		
-		sjf_file<<"Average Waiting Time = "<<avg_waiting_time<<endl<<endl;  //Prints the average waiting time
-		
-		sjf_file<<"Total Cycles = "<<total_cycles;
+	size_t rank = (size_t)ceil(percent / 100.0 * values.size()); //Position of the percentile in a sorted copy of the values (starting at 1)
 	
-		sjf_file.close(); //Closes the output file
-		
-		reset_processes(head, num_processes); //Resets all processes
+	if(rank < 1)
+	{
+		rank = 1;
 	}
-	else
+	else if(rank > values.size())
 	{
-		cout<<"Unable to open the SJF (Shortest Job First) output file for a single processor system.";
+		rank = values.size();
 	}
+	
+	nth_element(values.begin(), values.begin() + (rank - 1), values.end()); //Moves the value at the rank into place without sorting all of the values
+	
+	return values[rank - 1];
 }
 
-//Runs the Shortest Job First scheduling algorithm for the set of processes in a single processor system
-void SJF_multiprocessor(node *head, int num_processes, int processor_count)
+//Scheduling policies for choosing which waiting process a free processor executes next
+enum scheduling_policy
 {
-	ofstream sjf_file("SJF Output (multi-processor).txt"); //Declares an output file stream to write to a file for SJF (Shortest Job First) multi-processor scheduling output
+	POLICY_SJF, //Shortest Job First: the process with the fewest CPU cycles
+	POLICY_AGING, //SJF with aging: a process' effective CPU cycles shrink the longer it waits, so long processes cannot starve
+	POLICY_HRRN, //Approximate Highest Response Ratio Next: the process with the largest (waiting time + CPU cycles) / CPU cycles, out of the earliest arrival in each 1% burst length bucket
+	POLICY_EDF, //Earliest Deadline First: the process with the earliest deadline (processes with no deadline go last, in SJF order)
+	POLICY_SJF_FEASIBLE //SJF among feasible processes: the shortest process that can still finish by its deadline (processes that cannot only run when no other process can)
+};
 
-	//Runs the SJF (Shortest Job First) scheduling algorithm for processes if the file to write to has been opened without errors
-	if (sjf_file.is_open())
-	{		
-		process_queue = process_list; //Moves the Doubly Linked List of processes (copied to process_list previously) and creates a process queue
+//Ready job stored in a priority_queue along with its priority key (smaller keys execute first)
+struct keyed_job
+{
+	double key;
+	ready_job job;
+};
+
+//Orders keyed jobs so the smallest key is on top of a priority_queue (ties are broken the same way as SJF)
+struct smallest_key_first
+{
+	bool operator()(const keyed_job &a, const keyed_job &b) const
+	{
+		if(a.key != b.key)
+		{
+			return a.key > b.key;
+		}
 		
-		//Sorts the process queue from shortest CPU cycles (shortest job) required to execute to the largest CPU Cycles required to execute
-		sort(process_queue.begin(), process_queue.end(), [](const node *a, const node *b) { 
-			return a->CPU_cycles < b->CPU_cycles;
-		});
+		return shortest_job_first()(a.job, b.job);
+	}
+};
+
+//Process queue that hands out the next process to execute based on a scheduling policy
+//SJF and aging use a heap: with aging, effective cycles = CPU_cycles - aging_rate * (current_time - arrival_time), and since aging_rate * current_time
+//is the same for every waiting process, ordering by CPU_cycles + aging_rate * arrival_time never changes while processes wait (no re-sorting or re-keying)
+//HRRN ranks change over time, so processes are grouped into buckets of burst lengths that are within HRRN_BUCKET_WIDTH of each other:
+//inside a bucket the earliest arrival has the highest response ratio (exact for equal burst lengths), so only the front of each non-empty bucket is compared
+//(this makes it an approximation of HRRN: a later arrival with a slightly shorter burst in the same bucket can have a higher response ratio than the front)
+//EDF uses a heap keyed by deadline. SJF among feasible processes uses an SJF heap plus a late heap: a process that can no longer finish by its deadline
+//(current_time + CPU_cycles > deadline) stays that way as time moves forward, so it is moved to the late heap when it reaches the top and is never checked again
+struct policy_queue
+{
+	scheduling_policy policy;
+	double aging_rate; //Cycles of priority gained for each cycle spent waiting (aging only)
+	priority_queue<keyed_job, vector<keyed_job>, smallest_key_first> heap; //Waiting processes for SJF, aging, EDF, and SJF among feasible processes
+	priority_queue<keyed_job, vector<keyed_job>, smallest_key_first> late_heap; //Waiting processes that can no longer meet their deadline (SJF among feasible processes only)
+	vector< deque<ready_job> > buckets; //Waiting processes for HRRN, in arrival order within each burst length bucket
+	vector<int> active_buckets; //Indexes of the non-empty HRRN buckets
+	size_t size; //Number of waiting processes
+};
+
+const double HRRN_BUCKET_WIDTH = 0.01; //Burst lengths in the same HRRN bucket differ by less than 1%
+
+//Returns the HRRN bucket of a burst length (geometric buckets, so the burst lengths in a bucket differ by less than HRRN_BUCKET_WIDTH)
+int hrrn_bucket(int CPU_cycles)
+{
+	return (int)(log((double)max(CPU_cycles, 1)) / log(1 + HRRN_BUCKET_WIDTH));
+}
+
+//Initializes an empty process queue for a scheduling policy
+void init_policy_queue(policy_queue &queue, scheduling_policy policy, double aging_rate)
+{
+	queue.policy = policy;
+	queue.aging_rate = aging_rate;
+	queue.heap = priority_queue<keyed_job, vector<keyed_job>, smallest_key_first>();
+	queue.late_heap = priority_queue<keyed_job, vector<keyed_job>, smallest_key_first>();
+	queue.buckets.clear();
+	queue.active_buckets.clear();
+	queue.size = 0;
+}
+
+//Adds a process that has arrived to the process queue
+void push_policy_queue(policy_queue &queue, const ready_job &job)
+{
+	queue.size++;
+	
+	if(queue.policy == POLICY_HRRN)
+	{
+		int bucket = hrrn_bucket(job.CPU_cycles);
 		
-		//Prints Title
-		sjf_file<<"SJF (Shortest Job First) Schedule (Multi-Processor System):"<<endl<<endl;
+		if(bucket >= (int)queue.buckets.size())
+		{
+			queue.buckets.resize(bucket + 1);
+		}
 		
-		int current_time = 0, total_waiting_time = 0; //Declares and initializes current_time (for keeping track of the current execution time) and total_waiting_time (for keeping track of the waiting time for all processes overall)
-
-		int i = 0; //Declares and initializes a variable i (used for the current index in the process queue)
+		if(queue.buckets[bucket].empty())
+		{
+			queue.active_buckets.push_back(bucket);
+		}
+		
+		queue.buckets[bucket].push_back(job);
+	}
+	else
+	{
+		double key = job.CPU_cycles;
+		
+		if(queue.policy == POLICY_AGING)
+		{
+			key += queue.aging_rate * job.arrival_time;
+		}
+		else if(queue.policy == POLICY_EDF)
+		{
+			key = job.deadline;
+		}
 		
-		int processor_cycles[4] = {0, 0, 0, 0}; //Declares and initializes an array of processor cycles (keeps track of REMAINING processor cycles)
+		keyed_job entry = {key, job};
+		queue.heap.push(entry);
+	}
+}
+
+//Removes and returns the process that the scheduling policy executes next at the current time (current_time can never go backwards between calls)
+ready_job pop_policy_queue(policy_queue &queue, long long current_time)
+{
+	queue.size--;
+	
+	if(queue.policy == POLICY_SJF_FEASIBLE)
+	{
+		//Loop used to move the shortest processes that can no longer meet their deadline to the late heap, until the shortest feasible process is on top
+		while(!queue.heap.empty() && current_time + queue.heap.top().job.CPU_cycles > queue.heap.top().job.deadline)
+		{
+			queue.late_heap.push(queue.heap.top());
+			queue.heap.pop();
+		}
 		
-		int min_cycles_index = 0; //Used for determining which index holds the smallest remaining time for the next time in the multi-processor schedule
+		//If no waiting process can meet its deadline: Executes the shortest late process
+		priority_queue<keyed_job, vector<keyed_job>, smallest_key_first> &source = queue.heap.empty() ? queue.late_heap : queue.heap;
 		
-		int processor1_index = 0, processor2_index = 0, processor3_index = 0, processor4_index = 0;  //Index variables to keep track of where the currently executing process is located in each processor's schedule
+		ready_job job = source.top().job;
+		source.pop();
 		
+		return job;
+	}
+	
+	if(queue.policy != POLICY_HRRN)
+	{
+		ready_job job = queue.heap.top().job;
+		queue.heap.pop();
 		
-		//bool cycles_changed = false, 
-		bool empty_processor = false, processes_left = true; //empty_processor: used initially to determine when a processor is empty (no executing processes), processes_left: keeps track of whether there are more processes that need to be executed or not
+		return job;
+	}
+	
+	int best = 0; //Position in active_buckets of the bucket holding the highest response ratio
+	double best_ratio = -1;
+	
+	//Loop through the front of each non-empty bucket to find the highest response ratio (ties go to the shorter job)
+	for(int index = 0; index < (int)queue.active_buckets.size(); index++)
+	{
+		const ready_job &front = queue.buckets[queue.active_buckets[index]].front();
+		const ready_job &current_best = queue.buckets[queue.active_buckets[best]].front();
 		
-		int processes_executed = 0; //counts how many processes have finished executing so far
+		double ratio = (double)(current_time - front.arrival_time) / front.CPU_cycles; //Response ratio - 1 (same order as the response ratio)
 		
-		//Loop used to generate an SJF (Shortest Job First) schedule for a multi-processor system
-		while( processes_left )
+		if(ratio > best_ratio || (ratio == best_ratio && shortest_job_first()(current_best, front)))
 		{
-			//If the current process is ready to execute: execute the process in the process schedule
-			//Else: Go to the next process in the process queue
-			if(process_queue[i]->arrival_time <= current_time)
-			{
-				sjf_file<<"Current Time = "<<current_time<<endl; //Writes the current execution time to the output file
-				
-				//Writes headers to the output file
-				sjf_file<<"Processor\t\t"
-					  <<"Process ID\t"
-					  <<"Cycles\t"
-					  <<"Memory Footprint\t"
-					  <<"Arrival Time\t"
-					  <<"Start Time\t"
-					  <<"Stop Time\t"
-					  <<"Waiting Time\t"
-					  <<"Remaining Cycles"<<endl;
-				sjf_file<<"--------------------------------------------------------------------------------------------------------------------------------"<<endl;
-				
-				//If no processors are empty: Schedule the next process to execute
-				//Else: Schedule the next process to execute in the next empty processor
-				if(processor_cycles[min_cycles_index] > 0)
-				{
-					//If the process queue is NOT EMPTY: Remove the process that is done executing and schedule the next process to execute
-					if(!process_queue.empty())
-					{
-						//Remove the process that is done executing and schedule the next process to execute, based on which process has the smallest cycles remaining
-						switch(min_cycles_index)
-						{
-							case 0: //For Processor 1
-							{
-								processor1_schedule.push_back(process_queue[i]); //Add the new process to the processor schedule
-								processor1_index++; //Point to the new process to execute
-								
-								process_queue.erase(process_queue.begin()+i); //Delete the finished process from the process queue
-								
-								processor1_schedule[processor1_index]->start_time = current_time; //Set the start time for the new process
-								processor1_schedule[processor1_index]->stop_time = current_time + processor1_schedule[processor1_index]->CPU_cycles; //Calculate and set the stop time for the new process
-								
-								processor1_schedule[processor1_index]->waiting_time = current_time - processor1_schedule[processor1_index]->arrival_time; //Calculate and set the waiting time for the new process
-								total_waiting_time += processor1_schedule[processor1_index]->waiting_time; //Increment the new waiting time into the total waiting time overall
-							
-								processor_cycles[0] = processor1_schedule[processor1_index]->CPU_cycles; //Initialize processor cycles
-								
-								break;
-							}
-							case 1: //For Processor 2
-							{
-								processor2_schedule.push_back(process_queue[i]); //Add the new process to the processor schedule
-								processor2_index++; //Point to the new process to execute
-							
-								process_queue.erase(process_queue.begin()+i); //Delete the finished process from the process queue
-								
-								processor2_schedule[processor2_index]->start_time = current_time; //Set the start time for the new process
-								processor2_schedule[processor2_index]->stop_time = current_time + processor2_schedule[processor2_index]->CPU_cycles; //Calculate and set the stop time for the new process
-								
-								processor2_schedule[processor2_index]->waiting_time = current_time - processor2_schedule[processor2_index]->arrival_time; //Calculate and set the waiting time for the new process
-								total_waiting_time += processor2_schedule[processor2_index]->waiting_time; //Increment the new waiting time into the total waiting time overall
-						
-								processor_cycles[1] = processor2_schedule[processor2_index]->CPU_cycles; //Initialize processor cycles
-								
-								break;
-							}
-							case 2: //For Processor 3
-							{
-								processor3_schedule.push_back(process_queue[i]); //Add the new process to the processor schedule
-								processor3_index++; //Point to the new process to execute
-							
-								process_queue.erase(process_queue.begin()+i); //Delete the finished process from the process queue
-								
-								processor3_schedule[processor3_index]->start_time = current_time; //Set the start time for the new process
-								processor3_schedule[processor3_index]->stop_time = current_time + processor3_schedule[processor3_index]->CPU_cycles; //Calculate and set the stop time for the new process
-								
-								processor3_schedule[processor3_index]->waiting_time = current_time - processor3_schedule[processor3_index]->arrival_time; //Calculate and set the waiting time for the new process
-								total_waiting_time += processor3_schedule[processor3_index]->waiting_time; //Increment the new waiting time into the total waiting time overall
-						
-								processor_cycles[2] = processor3_schedule[processor3_index]->CPU_cycles; //Initialize processor cycles
-								
-								break;
-							}
-							case 3: //For Processor 4
-							{
-								processor4_schedule.push_back(process_queue[i]); //Add the new process to the processor schedule
-								processor4_index++; //Point to the new process to execute
-							
-								process_queue.erase(process_queue.begin()+i); //Delete the finished process from the process queue
-								
-								processor4_schedule[processor4_index]->start_time = current_time; //Set the start time for the new process
-								processor4_schedule[processor4_index]->stop_time = current_time + processor4_schedule[processor4_index]->CPU_cycles; //Calculate and set the stop time for the new process
-								
-								processor4_schedule[processor4_index]->waiting_time = current_time - processor4_schedule[processor4_index]->arrival_time; //Calculate and set the waiting time for the new process
-								total_waiting_time += processor4_schedule[processor4_index]->waiting_time; //Increment the new waiting time into the total waiting time overall
-							
-								processor_cycles[3] = processor4_schedule[processor4_index]->CPU_cycles; //Initialize processor cycles
-								
-								break;
-							}
-						}
-					}
+			best_ratio = ratio;
+			best = index;
+		}
+	}
+	
+	deque<ready_job> &bucket = queue.buckets[queue.active_buckets[best]];
+	ready_job job = bucket.front();
+	bucket.pop_front();
+	
+	//If the bucket is now empty: Swap it with the last active bucket and remove it
+	if(bucket.empty())
+	{
+		queue.active_buckets[best] = queue.active_buckets.back();
+		queue.active_buckets.pop_back();
+	}
+	
+	return job;
+}
+
+//Returns the name of a scheduling policy (used for output)
+string scheduling_policy_name(scheduling_policy policy)
+{
+	switch(policy)
+	{
+		case POLICY_SJF:
+			return "SJF";
+		case POLICY_AGING:
+			return "SJF with Aging";
+		case POLICY_HRRN:
+			return "Approximate HRRN";
+		case POLICY_EDF:
+			return "EDF";
+		default:
+			return "SJF (Feasible)";
+	}
+}
+
+//Start time, stop time, and processor chosen for a process by schedule_jobs
+struct schedule_entry
+{
+	long long start_time;
+	long long stop_time;
+	int processor;
+	bool rejected; //Turned away by admission control (never executed: start time = stop time = arrival time and processor = -1)
+};
+
+//Fenwick tree (binary indexed tree) of the CPU cycles of the waiting processes, indexed by each process' rank in the scheduling policy's order
+//Used by admission control to add up the work waiting ahead of an arriving process in O(log n)
+struct work_tree
+{
+	vector<long long> sums;
+};
+
+//Adds cycles (or removes them, if negative) at a rank (0 - sums.size() - 1)
+void add_work(work_tree &tree, int rank, long long cycles)
+{
+	for(int index = rank + 1; index <= (int)tree.sums.size(); index += index & -index)
+	{
+		tree.sums[index - 1] += cycles;
+	}
+}
+
+//Returns the total cycles at the ranks before rank
+long long work_before(const work_tree &tree, int rank)
+{
+	long long total = 0;
+	
+	for(int index = rank; index > 0; index -= index & -index)
+	{
+		total += tree.sums[index - 1];
+	}
+	
+	return total;
+}
+
+//Returns each job's rank (indexed by process ID - 1) in the order the scheduling policy would execute the jobs if they were all waiting at once
+//(EDF orders by deadline, aging by its fixed heap key, and every other policy by CPU cycles, with ties broken the same way as SJF)
+vector<int> policy_ranks(const vector<ready_job> &jobs, scheduling_policy policy, double aging_rate)
+{
+	vector<keyed_job> order(jobs.size());
+	
+	for(size_t i = 0; i < jobs.size(); i++)
+	{
+		order[i].job = jobs[i];
+		order[i].key = (policy == POLICY_EDF) ? jobs[i].deadline : (policy == POLICY_AGING) ? jobs[i].CPU_cycles + aging_rate * jobs[i].arrival_time : jobs[i].CPU_cycles;
+	}
+	
+	//smallest_key_first puts the smallest key on top of a heap, so sorting with it puts the smallest key last
+	sort(order.begin(), order.end(), smallest_key_first());
+	
+	vector<int> ranks(jobs.size());
+	
+	for(size_t index = 0; index < order.size(); index++)
+	{
+		ranks[order[index].job.process_ID - 1] = order.size() - 1 - index;
+	}
+	
+	return ranks;
+}
+
+//Schedules a set of jobs (in arrival order, with process IDs 1 - jobs.size()) on processor_count processors using a scheduling policy
+//Non-preemptive: whenever a processor is free, it executes the process chosen by the policy out of the processes that have arrived
+//If admission_control is true: A process with a deadline is rejected when it arrives if it cannot finish by its deadline, estimating its start time as
+//its arrival time plus the work still running and the work waiting ahead of it (in the policy's order), spread over every processor
+//(a heuristic: later arrivals that run ahead of it and uneven processor loads are not counted, so an admitted process can still miss its deadline)
+//Stores the schedule for each process at index process ID - 1 (only touches its own arguments, so schedules can run in parallel)
+void schedule_jobs(const vector<ready_job> &jobs, int processor_count, scheduling_policy policy, double aging_rate, bool admission_control, vector<schedule_entry> &schedule)
+{
+	int num_processes = jobs.size();
+	
+	schedule.resize(num_processes);
+	
+	policy_queue ready;
+	init_policy_queue(ready, policy, aging_rate);
+	
+	vector<int> ranks; //Rank of each process in the policy's order (admission control only)
+	work_tree waiting_work; //CPU cycles of the waiting processes by rank (admission control only)
+	priority_queue< long long, vector<long long>, greater<long long> > running_stops; //Stop times of the processes that have started, earliest first (admission control only)
+	long long running_stop_sum = 0; //Total of the stop times in running_stops
+	
+	if(admission_control)
+	{
+		ranks = policy_ranks(jobs, policy, aging_rate);
+		waiting_work.sums.assign(num_processes, 0);
+	}
+	
+	//Keeps track of the time each processor becomes free, earliest first (ties go to the lower processor index)
+	priority_queue< pair<long long, int>, vector< pair<long long, int> >, greater< pair<long long, int> > > free_processors;
+	
+	for(int index = 0; index < processor_count; index++)
+	{
+		free_processors.push(make_pair(0LL, index));
+	}
+	
+	int next_arrival = 0; //Index in jobs of the next process that has not arrived yet
+	
+	int handled = 0; //Number of processes handed to a processor or rejected
+	
+	//Loop used to hand a process to the next free processor until every process has been scheduled
+	while(handled < num_processes)
+	{
+		long long current_time = free_processors.top().first;
+		int processor = free_processors.top().second;
+		free_processors.pop();
+		
+		//Adds every process that has arrived by the current time to the process queue
+		while(next_arrival < num_processes && jobs[next_arrival].arrival_time <= current_time)
+		{
+			const ready_job &arrival = jobs[next_arrival];
+			
+			next_arrival++;
+			
+			if(admission_control)
+			{
+				//Removes the processes that finished before this one arrived from the running work
+				while(!running_stops.empty() && running_stops.top() <= arrival.arrival_time)
+				{
+					running_stop_sum -= running_stops.top();
+					running_stops.pop();
+				}
+				
+				long long work_ahead = work_before(waiting_work, ranks[arrival.process_ID - 1]);
+				long long running_work = running_stop_sum - (long long)running_stops.size() * arrival.arrival_time;
+				
+				//If a processor is idle and nothing is waiting ahead: The process can start right away
+				double estimated_start = arrival.arrival_time;
+				
+				if((int)running_stops.size() >= processor_count || work_ahead > 0)
+				{
+					estimated_start += (double)(running_work + work_ahead) / processor_count;
+				}
+				
+				//If the process has a deadline it cannot meet: Rejects it
+				if(arrival.deadline != NO_DEADLINE && estimated_start + arrival.CPU_cycles > arrival.deadline)
+				{
+					schedule_entry &entry = schedule[arrival.process_ID - 1];
+					
+					entry.start_time = arrival.arrival_time;
+					entry.stop_time = arrival.arrival_time;
+					entry.processor = -1;
+					entry.rejected = true;
+					
+					handled++;
+					continue;
+				}
+				
+				add_work(waiting_work, ranks[arrival.process_ID - 1], arrival.CPU_cycles);
+			}
+			
+			push_policy_queue(ready, arrival);
+		}
+		
+		//If no processes are waiting: The processor sits idle until the next process arrives
+		//(it goes back into the free processors, so processors that were free earlier don't take processes before they arrive)
+		if(ready.size == 0)
+		{
+			if(next_arrival < num_processes)
+			{
+				free_processors.push(make_pair(jobs[next_arrival].arrival_time, processor));
+			}
+			
+			continue;
+		}
+		
+		ready_job job = pop_policy_queue(ready, current_time);
+		schedule_entry &entry = schedule[job.process_ID - 1];
+		
+		entry.start_time = current_time;
+		entry.stop_time = current_time + job.CPU_cycles;
+		entry.processor = processor;
+		entry.rejected = false;
+		
+		free_processors.push(make_pair(entry.stop_time, processor));
+		
+		if(admission_control)
+		{
+			add_work(waiting_work, ranks[job.process_ID - 1], -job.CPU_cycles);
+			
+			running_stops.push(entry.stop_time);
+			running_stop_sum += entry.stop_time;
+		}
+		
+		handled++;
+	}
+}
+
+//Returns true if process a should execute before process b at the current time under a scheduling policy (used by reference_schedule)
+bool reference_runs_first(const ready_job &a, const ready_job &b, scheduling_policy policy, double aging_rate, long long current_time)
+{
+	double a_value = a.CPU_cycles, b_value = b.CPU_cycles; //Smaller values execute first
+	
+	if(policy == POLICY_AGING)
+	{
+		a_value = a.CPU_cycles - aging_rate * (current_time - a.arrival_time);
+		b_value = b.CPU_cycles - aging_rate * (current_time - b.arrival_time);
+	}
+	else if(policy == POLICY_HRRN)
+	{
+		a_value = -(double)(current_time - a.arrival_time) / a.CPU_cycles; //Negative response ratio - 1, so the highest response ratio is the smallest value
+		b_value = -(double)(current_time - b.arrival_time) / b.CPU_cycles;
+	}
+	else if(policy == POLICY_EDF && a.deadline != b.deadline)
+	{
+		return a.deadline < b.deadline;
+	}
+	else if(policy == POLICY_SJF_FEASIBLE)
+	{
+		bool a_late = current_time + a.CPU_cycles > a.deadline, b_late = current_time + b.CPU_cycles > b.deadline;
+		
+		//A process that can still meet its deadline goes before one that cannot
+		if(a_late != b_late)
+		{
+			return b_late;
+		}
+	}
+	
+	if(a_value != b_value)
+	{
+		return a_value < b_value;
+	}
+	
+	return shortest_job_first()(b, a); //Ties go to the shorter job, then the earlier arrival, then the lower process ID
+}
+
+//Reference scheduler used to check the faster schedulers: a direct version of the same non-preemptive policy rules with no data structures
+//At each step the processor that is free first (lowest index on ties) takes the best process out of every process that has arrived, comparing
+//every waiting process with the policy's formula at that moment. This is O(n^2), so it is only meant for small sets of processes
+//For HRRN, only the earliest waiting process (in jobs order) in each HRRN bucket is compared, the same approximation the policy scheduler makes
+void reference_schedule(const vector<ready_job> &jobs, int processor_count, scheduling_policy policy, double aging_rate, vector<schedule_entry> &schedule)
+{
+	int num_processes = jobs.size();
+	
+	vector<long long> free_time(processor_count, 0); //Time each processor becomes free
+	vector<bool> scheduled(num_processes, false);
+	vector<int> bucket_seen(hrrn_bucket(INT_MAX) + 1, -1); //Step in which each HRRN bucket's earliest waiting process was found (HRRN only)
+	
+	schedule.resize(num_processes);
+	
+	for(int count = 0; count < num_processes; count++)
+	{
+		int processor = 0;
+		
+		//Finds the processor that becomes free first
+		for(int index = 1; index < processor_count; index++)
+		{
+			if(free_time[index] < free_time[processor])
+			{
+				processor = index;
+			}
+		}
+		
+		long long current_time = free_time[processor], first_arrival = LLONG_MAX;
+		
+		//Finds the earliest arrival out of the processes that are left (the processor sits idle until then if nothing has arrived yet)
+		for(int i = 0; i < num_processes; i++)
+		{
+			if(!scheduled[i])
+			{
+				first_arrival = min(first_arrival, jobs[i].arrival_time);
+			}
+		}
+		
+		current_time = max(current_time, first_arrival);
+		
+		int best = -1;
+		
+		//Finds the best process out of the processes that have arrived
+		for(int i = 0; i < num_processes; i++)
+		{
+			if(scheduled[i] || jobs[i].arrival_time > current_time)
+			{
+				continue;
+			}
+			
+			//If using HRRN: Skips every process behind the earliest waiting process in its bucket
+			if(policy == POLICY_HRRN)
+			{
+				int bucket = hrrn_bucket(jobs[i].CPU_cycles);
+				
+				if(bucket_seen[bucket] == count)
+				{
+					continue;
+				}
+				
+				bucket_seen[bucket] = count;
+			}
+			
+			if(best == -1 || reference_runs_first(jobs[i], jobs[best], policy, aging_rate, current_time))
+			{
+				best = i;
+			}
+		}
+		
+		scheduled[best] = true;
+		
+		schedule_entry &entry = schedule[jobs[best].process_ID - 1];
+		entry.start_time = current_time;
+		entry.stop_time = current_time + jobs[best].CPU_cycles;
+		entry.processor = processor;
+		entry.rejected = false;
+		
+		free_time[processor] = entry.stop_time;
+	}
+}
+
+//Schedules the processes in the process list on processor_count processors using a scheduling policy
+//Stores the start time, stop time, waiting time, and processor for every process in its node
+void schedule_processes(int num_processes, int processor_count, scheduling_policy policy, double aging_rate)
+{
+	vector<node*> arrivals(process_list.begin(), process_list.begin() + num_processes); //Processes in arrival order
+	
+	stable_sort(arrivals.begin(), arrivals.end(), [](const node *a, const node *b) {
+		return a->arrival_time < b->arrival_time;
+	});
+	
+	vector<ready_job> jobs(num_processes);
+	vector<schedule_entry> schedule;
+	
+	for(int i = 0; i < num_processes; i++)
+	{
+		ready_job job = {arrivals[i]->process_ID, arrivals[i]->CPU_cycles, arrivals[i]->arrival_time, arrivals[i]->deadline};
+		jobs[i] = job;
+	}
+	
+	schedule_jobs(jobs, processor_count, policy, aging_rate, false, schedule);
+	
+	//Copies the schedule into each process' node
+	for(int i = 0; i < num_processes; i++)
+	{
+		node *process = process_list[i];
+		
+		process->start_time = schedule[process->process_ID - 1].start_time;
+		process->stop_time = schedule[process->process_ID - 1].stop_time;
+		process->waiting_time = process->start_time - process->arrival_time;
+		process->processor = schedule[process->process_ID - 1].processor;
+	}
+}
+
+//Returns the lower edge of each burst length bucket for burst lengths between min_cycles and max_cycles
+vector<int> burst_bucket_edges(int min_cycles, int max_cycles)
+{
+	vector<int> bucket_edges;
+	
+	//If the burst lengths fit the Normal Distribution range (1,000 - 11,000 cycles): Uses the original 2,000 cycle wide buckets
+	if(max_cycles <= 11000)
+	{
+		for(int edge = 0; edge <= 10000; edge += 2000)
+		{
+			bucket_edges.push_back(edge);
+		}
+		
+		return bucket_edges;
+	}
+	
+	//Otherwise (e.g. a Pareto tail): Uses geometric edges on the 1, 2, 5, 10, 20, 50, ... scale, from the largest edge at or below min_cycles up to max_cycles,
+	//so the long processes are spread over several buckets instead of all landing in the last one
+	const int steps[3] = {1, 2, 5};
+	
+	bucket_edges.push_back(0);
+	
+	for(long long decade = 1; decade < max_cycles; decade *= 10)
+	{
+		for(int step = 0; step < 3; step++)
+		{
+			long long edge = decade * steps[step];
+			
+			if(edge >= max_cycles)
+			{
+				break;
+			}
+			
+			if(edge <= min_cycles)
+			{
+				bucket_edges[0] = edge;
+			}
+			else
+			{
+				bucket_edges.push_back(edge);
+			}
+		}
+	}
+	
+	return bucket_edges;
+}
+
+//Writes the average, p99.9, and max waiting times for each burst length (CPU cycles) bucket of the most recent schedule
+void write_waiting_time_buckets(ostream &out, int num_processes, const vector<int> &bucket_edges)
+{
+	const int bucket_count = bucket_edges.size();
+	
+	vector< vector<long long> > bucket_waits(bucket_count); //Waiting times for the processes in each bucket
+	vector<long long> all_waits;
+	
+	for(int i = 0; i < num_processes; i++)
+	{
+		int bucket = bucket_count - 1;
+		
+		while(bucket > 0 && process_list[i]->CPU_cycles < bucket_edges[bucket])
+		{
+			bucket--;
+		}
+		
+		bucket_waits[bucket].push_back(process_list[i]->waiting_time);
+		all_waits.push_back(process_list[i]->waiting_time);
+	}
+	
+	//Prints headers for output
+	out<<setw(15)<<left<<"Burst Length"<<"\t"
+	   <<"Processes\t"
+	   <<"Average Wait\t"
+	   <<"p99.9 Wait\t"
+	   <<"Max Wait"<<endl;
+	out<<"------------------------------------------------------------------------"<<endl;
+	
+	//Loop through the buckets (and then all processes) to print the waiting times
+	for(int bucket = 0; bucket <= bucket_count; bucket++)
+	{
+		vector<long long> &waits = (bucket < bucket_count) ? bucket_waits[bucket] : all_waits;
+		
+		string label = "All";
+		
+		if(bucket < bucket_count)
+		{
+			label = (bucket + 1 < bucket_count) ? to_string(bucket_edges[bucket]) + " - " + to_string(bucket_edges[bucket+1] - 1) : to_string(bucket_edges[bucket]) + "+";
+		}
+		
+		double avg_waiting_time = 0;
+		
+		for(size_t index = 0; index < waits.size(); index++)
+		{
+			avg_waiting_time += waits[index];
+		}
+		
+		if(!waits.empty())
+		{
+			avg_waiting_time /= waits.size();
+		}
+		
+		out<<setw(15)<<left<<label<<"\t"
+		   <<setw(9)<<right<<waits.size()<<"\t"
+		   <<setw(12)<<fixed<<setprecision(2)<<avg_waiting_time<<"\t"
+		   <<setw(10)<<percentile(waits, 99.9)<<"\t"
+		   <<setw(8)<<percentile(waits, 100)<<endl;
+	}
+}
+
+//Runs every scheduling policy (SJF, SJF with aging, and HRRN) on a single processor system and a multi-processor system
+//and writes the waiting times per burst length bucket (with edges spanning min_cycles - max_cycles), so the starvation of long processes can be compared against average waiting time
+void SJF_policy_comparison(int num_processes, int processor_count, double aging_rate, int min_cycles, int max_cycles)
+{
+	vector<int> bucket_edges = burst_bucket_edges(min_cycles, max_cycles);
+	
+	ofstream sjf_file(output_prefix + "SJF Output (policy comparison).txt"); //Declares an output file stream for the scheduling policy comparison output
+	
+	//Runs the comparison if the file has been opened without errors
+	if (sjf_file.is_open())
+	{
+		sjf_file<<"Scheduling Policy Comparison (Aging Rate = "<<aging_rate<<", HRRN Bucket Width = "<<HRRN_BUCKET_WIDTH * 100<<"%):"<<endl<<endl;
+		
+		const scheduling_policy policies[5] = {POLICY_SJF, POLICY_AGING, POLICY_HRRN, POLICY_EDF, POLICY_SJF_FEASIBLE};
+		const int processor_counts[2] = {1, processor_count};
+		
+		int deadline_processes = 0;
+		
+		for(int i = 0; i < num_processes; i++)
+		{
+			deadline_processes += (process_list[i]->deadline != NO_DEADLINE) ? 1 : 0;
+		}
+		
+		//The deadline policies (EDF and SJF among feasible processes) are only compared when some processes have deadlines
+		int policy_count = (deadline_processes > 0) ? 5 : 3;
+		
+		for(int system = 0; system < 2; system++)
+		{
+			for(int index = 0; index < policy_count; index++)
+			{
+				schedule_processes(num_processes, processor_counts[system], policies[index], aging_rate);
+				
+				sjf_file<<scheduling_policy_name(policies[index])<<" Schedule ("<<(system == 0 ? "Single Processor System" : to_string(processor_count) + " Processor System")<<"):"<<endl;
+				
+				write_waiting_time_buckets(sjf_file, num_processes, bucket_edges);
+				
+				//If some processes have deadlines: Prints how many of them missed their deadline
+				if(deadline_processes > 0)
+				{
+					int missed = 0;
 					
-					//Loop through the processors and print out the current process execution information for each
-					for(int index = 0; index < processor_count; index++)
+					for(int i = 0; i < num_processes; i++)
 					{
-						//Print out the current processor's (based on index) current process execution information based on the current processor
-						switch(index)
-						{
-							case 0: //For Processor 1
-							{
-								//Calculate and set the current remaining cycles left for the current process
-								processor_cycles[0] = processor1_schedule[processor1_index]->stop_time - current_time;
-								processor1_schedule[processor1_index]->remaining_cycles = processor_cycles[0];
-								
-								//If there are remaining cycles to execute: Print out current processes' information for the schedule
-								//Else: The processor is currently empty (set empty_processor = true)
-								if(processor_cycles[0] > 0)
-								//if(processor1_index < processor1_schedule.size())
-								{									
-									//Prints the currently executing process' information
-									sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-										  <<setw(10)<<"p" + to_string( processor1_schedule[processor1_index]->process_ID )<<"\t"
-										  <<setw(6)<<right<<processor1_schedule[processor1_index]->CPU_cycles<<"\t"
-										  <<setw(16)<<processor1_schedule[processor1_index]->memory_footprint<<"\t"
-										  <<setw(12)<<processor1_schedule[processor1_index]->arrival_time<<"\t"
-										  <<setw(10)<<processor1_schedule[processor1_index]->start_time<<"\t" //Prints out the start time
-										  <<setw(9)<<processor1_schedule[processor1_index]->stop_time<<"\t" //Prints out the stop time
-										  <<setw(12)<<processor1_schedule[processor1_index]->waiting_time<<"\t" //Prints waiting time
-										  <<setw(16)<<processor1_schedule[processor1_index]->remaining_cycles<<endl; //Prints remaining cycles
-								}
-								else
-								{
-									empty_processor = true;
-								}
-								
-								break;
-							}
-							case 1: //For Processor 2
-							{							
-								//Calculate and set the current remaining cycles left for the current process
-								processor_cycles[1] = processor2_schedule[processor2_index]->stop_time - current_time;
-								processor2_schedule[processor2_index]->remaining_cycles = processor_cycles[1];
-							
-								//If there are remaining cycles to execute: Print out current processes' information for the schedule
-								//Else: The processor is currently empty (set empty_processor = true)
-								if(processor_cycles[1] > 0)
-								{
-									//Prints the currently executing process' information
-									sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-										  <<setw(10)<<"p" + to_string( processor2_schedule[processor2_index]->process_ID )<<"\t"
-										  <<setw(6)<<right<<processor2_schedule[processor2_index]->CPU_cycles<<"\t"
-										  <<setw(16)<<processor2_schedule[processor2_index]->memory_footprint<<"\t"
-										  <<setw(12)<<processor2_schedule[processor2_index]->arrival_time<<"\t"
-										  <<setw(10)<<processor2_schedule[processor2_index]->start_time<<"\t" //Prints out the start time
-										  <<setw(9)<<processor2_schedule[processor2_index]->stop_time<<"\t" //Prints out the stop time
-										  <<setw(12)<<processor2_schedule[processor2_index]->waiting_time<<"\t" //Prints waiting time
-										  <<setw(16)<<processor2_schedule[processor2_index]->remaining_cycles<<endl; //Prints remaining cycles
-								}
-								else
-								{
-									empty_processor = true;
-								}
-								
-								break;
-							}
-							case 2: //For Processor 3
-							{
-								//Calculate and set the current remaining cycles left for the current process
-								processor_cycles[2] = processor3_schedule[processor3_index]->stop_time - current_time;
-								processor3_schedule[processor3_index]->remaining_cycles = processor_cycles[2];
-								
-								//If there are remaining cycles to execute: Print out current processes' information for the schedule
-								//Else: The processor is currently empty (set empty_processor = true)
-								if(processor_cycles[2] > 0)
-								{
-									//Prints the currently executing process' information
-									sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-										  <<setw(10)<<"p" + to_string( processor3_schedule[processor3_index]->process_ID )<<"\t"
-										  <<setw(6)<<right<<processor3_schedule[processor3_index]->CPU_cycles<<"\t"
-										  <<setw(16)<<processor3_schedule[processor3_index]->memory_footprint<<"\t"
-										  <<setw(12)<<processor3_schedule[processor3_index]->arrival_time<<"\t"
-										  <<setw(10)<<processor3_schedule[processor3_index]->start_time<<"\t" //Prints out the start time
-										  <<setw(9)<<processor3_schedule[processor3_index]->stop_time<<"\t" //Prints out the stop time
-										  <<setw(12)<<processor3_schedule[processor3_index]->waiting_time<<"\t" //Prints waiting time
-										  <<setw(16)<<processor3_schedule[processor3_index]->remaining_cycles<<endl; //Prints remaining cycles
-								}
-								else
-								{
-									empty_processor = true;
-								}
-								
-								break;
-							}
-							case 3: //For Processor 4
-							{
-								//Calculate and set the current remaining cycles left for the current process
-								processor_cycles[3] = processor4_schedule[processor4_index]->stop_time - current_time;
-								processor4_schedule[processor4_index]->remaining_cycles = processor_cycles[3];
-								
-								//If there are remaining cycles to execute: Print out current processes' information for the schedule
-								//Else: The processor is currently empty (set empty_processor = true)
-								if(processor_cycles[3] > 0)
-								{
-									//Prints the currently executing process' information
-									sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-										  <<setw(10)<<"p" + to_string( processor4_schedule[processor4_index]->process_ID )<<"\t"
-										  <<setw(6)<<right<<processor4_schedule[processor4_index]->CPU_cycles<<"\t"
-										  <<setw(16)<<processor4_schedule[processor4_index]->memory_footprint<<"\t"
-										  <<setw(12)<<processor4_schedule[processor4_index]->arrival_time<<"\t"
-										  <<setw(10)<<processor4_schedule[processor4_index]->start_time<<"\t" //Prints out the start time
-										  <<setw(9)<<processor4_schedule[processor4_index]->stop_time<<"\t" //Prints out the stop time
-										  <<setw(12)<<processor4_schedule[processor4_index]->waiting_time<<"\t" //Prints waiting time
-										  <<setw(16)<<processor4_schedule[processor4_index]->remaining_cycles<<endl; //Prints remaining cycles
-								}
-								else
-								{
-									empty_processor = true;
-								}
-								
-								break;
-							}
-						}
-						
-						//If the current processor is empty: Print empty values (represented as - symbols)
-						if(empty_processor)
-						{
-							//Prints the currently generated process' information
-							sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-								  <<setw(10)<<"-"<<"\t"
-								  <<setw(6)<<right<<"-"<<"\t"
-								  <<setw(16)<<"-"<<"\t"
-								  <<setw(12)<<"-"<<"\t"
-								  <<setw(10)<<"-"<<"\t"
-								  <<setw(9)<<"-"<<"\t"
-								  <<setw(12)<<"-"<<"\t"
-								  <<setw(16)<<"-"<<endl;
-							
-							//If all processes have been executed: No more processes are left to execute (set processes_left = false)
-							if(processes_executed == 50)
-							{
-								processes_left = false;
-							}
-							
-							empty_processor = false; //Reset the empty processor status for the next processor
-						}
+						missed += (process_list[i]->stop_time > process_list[i]->deadline) ? 1 : 0;
 					}
+					
+					sjf_file<<"Deadline Misses = "<<missed<<" of "<<deadline_processes<<endl;
+				}
+				
+				sjf_file<<endl;
+			}
+		}
+		
+		sjf_file.close(); //Closes the output file
+	}
+	else
+	{
+		cout<<"Unable to open the scheduling policy comparison output file.";
+	}
+}
+
+//Runs the Shortest Job First scheduling algorithm for the set of processes in a single processor system
+void SJF_single_processor(node *head, int num_processes)
+{
+	ofstream sjf_file(output_prefix + "SJF Output (single processor).txt"); //Declares an output file stream for Shortest Job First scheduling output
+
+	//Runs the Shortest Job First scheduling algorithm for processes if the file has been opened without errors
+	if (sjf_file.is_open())
+	{
+		schedule_processes(num_processes, 1, POLICY_SJF, 0); //Generates the SJF (Shortest Job First) schedule for a single processor system (ties go to the earlier arrival, then to the lower process ID)
+		
+		process_queue.assign(process_list.begin(), process_list.begin() + num_processes);
+		
+		//Sorts the process queue in start time order
+		stable_sort(process_queue.begin(), process_queue.end(), [](const node *a, const node *b) { 
+			return a->start_time < b->start_time;
+		});
+		
+		//Prints headers for output
+		sjf_file<<"SJF (Shortest Job First) Schedule (Single Processor System):"<<endl<<endl;
+		sjf_file<<"Process Order\t"
+				<<"Cycles\t"
+				<<"Memory Footprint\t"
+				<<"Arrival Time\t"
+				<<"Start Time\t"
+				<<"Stop Time\t"
+				<<"Waiting Time"<<endl;
+		sjf_file<<"------------------------------------------------------------------------------------------------"<<endl;
+		
+		long long total_waiting_time = 0;
+		
+		//Loop through the process queue to print each process in the order it executed
+		for(size_t i = 0; i < process_queue.size(); i++)
+		{
+			node *process = process_queue[i];
+			
+			total_waiting_time += process->waiting_time; //Increments the total waiting time overall
+			
+			//Prints the current process' information
+			sjf_file<<setw(13)<<left<<"p" + to_string( process->process_ID )<<"\t"
+					<<setw(6)<<right<<process->CPU_cycles<<"\t"
+					<<setw(16)<<process->memory_footprint<<"\t"
+					<<setw(12)<<process->arrival_time<<"\t"
+					<<setw(10)<<process->start_time<<"\t" //Prints out the start time
+					<<setw(10)<<process->stop_time<<"\t" //Prints out the stop time
+					<<setw(12)<<process->waiting_time<<endl;
+		}
+		
+		sjf_file<<endl;
+	
+		double avg_waiting_time = 0;
+		
+		avg_waiting_time = (double)total_waiting_time / num_processes;
+		
+		sjf_file<<"Average Waiting Time = "<<fixed<<setprecision(2)<<avg_waiting_time<<endl<<endl;  //Prints the average waiting time
+		
+		sjf_file<<"Total Cycles = "<<total_cycles;
+	
+		sjf_file.close(); //Closes the output file
+		
+		reset_processes(head, num_processes); //Resets all processes
+	}
+	else
+	{
+		cout<<"Unable to open the SJF (Shortest Job First) output file for a single processor system.";
+	}
+}
+
+//Runs the Shortest Job First scheduling algorithm for the set of processes in a multi-processor system
+void SJF_multiprocessor(node *head, int num_processes, int processor_count)
+{
+	ofstream sjf_file(output_prefix + "SJF Output (multi-processor).txt"); //Declares an output file stream to write to a file for SJF (Shortest Job First) multi-processor scheduling output
+
+	//Runs the SJF (Shortest Job First) scheduling algorithm for processes if the file to write to has been opened without errors
+	if (sjf_file.is_open())
+	{
+		schedule_processes(num_processes, processor_count, POLICY_SJF, 0); //Generates the SJF (Shortest Job First) schedule for a multi-processor system
+		
+		//Builds each processor's schedule in start time order
+		processor_schedules.assign(processor_count, vector<node*>());
+		
+		vector<long long> event_times; //Every time a process starts or stops executing
+		long long total_waiting_time = 0;
+		
+		for(int i = 0; i < num_processes; i++)
+		{
+			processor_schedules[process_list[i]->processor].push_back(process_list[i]);
+			
+			event_times.push_back(process_list[i]->start_time);
+			event_times.push_back(process_list[i]->stop_time);
+			
+			total_waiting_time += process_list[i]->waiting_time;
+		}
+		
+		for(int index = 0; index < processor_count; index++)
+		{
+			sort(processor_schedules[index].begin(), processor_schedules[index].end(), [](const node *a, const node *b) { 
+				return a->start_time < b->start_time;
+			});
+		}
+		
+		sort(event_times.begin(), event_times.end());
+		event_times.erase(unique(event_times.begin(), event_times.end()), event_times.end());
+		
+		//Prints Title
+		sjf_file<<"SJF (Shortest Job First) Schedule (Multi-Processor System):"<<endl<<endl;
+		
+		vector<int> processor_index(processor_count, 0); //Index variables to keep track of where the currently executing process is located in each processor's schedule
+		
+		//Loop used to print every processor's state each time a process starts or stops executing
+		for(size_t event = 0; event < event_times.size(); event++)
+		{
+			long long current_time = event_times[event];
+			
+			sjf_file<<"Current Time = "<<current_time<<endl; //Writes the current execution time to the output file
+			
+			//Writes headers to the output file
+			sjf_file<<"Processor\t\t"
+				  <<"Process ID\t"
+				  <<"Cycles\t"
+				  <<"Memory Footprint\t"
+				  <<"Arrival Time\t"
+				  <<"Start Time\t"
+				  <<"Stop Time\t"
+				  <<"Waiting Time\t"
+				  <<"Remaining Cycles"<<endl;
+			sjf_file<<"--------------------------------------------------------------------------------------------------------------------------------"<<endl;
+			
+			//Loop through the processors and print out the current process execution information for each
+			for(int index = 0; index < processor_count; index++)
+			{
+				vector<node*> &schedule = processor_schedules[index];
+				
+				//Skips past the processes that have finished executing on the current processor
+				while(processor_index[index] < (int)schedule.size() && schedule[processor_index[index]]->stop_time <= current_time)
+				{
+					processor_index[index]++;
+				}
+				
+				//If the current processor is executing a process: Print out the current process' information
+				//Else: Print empty values (represented as - symbols)
+				if(processor_index[index] < (int)schedule.size() && schedule[processor_index[index]]->start_time <= current_time)
+				{
+					node *process = schedule[processor_index[index]];
+					
+					process->remaining_cycles = process->stop_time - current_time; //Calculate and set the current remaining cycles left for the current process
+					
+					//Prints the currently executing process' information
+					sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
+						  <<setw(10)<<"p" + to_string( process->process_ID )<<"\t"
+						  <<setw(6)<<right<<process->CPU_cycles<<"\t"
+						  <<setw(16)<<process->memory_footprint<<"\t"
+						  <<setw(12)<<process->arrival_time<<"\t"
+						  <<setw(10)<<process->start_time<<"\t" //Prints out the start time
+						  <<setw(9)<<process->stop_time<<"\t" //Prints out the stop time
+						  <<setw(12)<<process->waiting_time<<"\t" //Prints waiting time
+						  <<setw(16)<<process->remaining_cycles<<endl; //Prints remaining cycles
+				}
+				else
+				{
+					sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
+						  <<setw(10)<<"-"<<"\t"
+						  <<setw(6)<<right<<"-"<<"\t"
+						  <<setw(16)<<"-"<<"\t"
+						  <<setw(12)<<"-"<<"\t"
+						  <<setw(10)<<"-"<<"\t"
+						  <<setw(9)<<"-"<<"\t"
+						  <<setw(12)<<"-"<<"\t"
+						  <<setw(16)<<"-"<<endl;
+				}
+			}
+			
+			sjf_file<<endl;
+		}
+		
+		sjf_file<<endl;
+		
+		double avg_waiting_time = 0;
+		
+		avg_waiting_time = (double)total_waiting_time / num_processes;
+		
+		sjf_file<<"Average Waiting Time = "<<fixed<<setprecision(2)<<avg_waiting_time;
+	
+		sjf_file.close();
+		
+		reset_processes(head, num_processes);
+	}
+	else
+	{
+		cout<<"Unable to open the SJF (Shortest Job First) output file for a multi-processor system.";
+	}
+}
+
+//Dispatching policies used by the front-end dispatcher of a cluster to choose which node receives each arriving job
+enum dispatch_policy
+{
+	DISPATCH_LEAST_WORK_LEFT, //Sends the job to the node with the least unfinished work (CPU cycles) left
+	DISPATCH_POWER_OF_TWO, //Samples two random nodes and sends the job to the one with fewer jobs
+	DISPATCH_JSQ //Join the Shortest Queue: sends the job to the node with the fewest jobs
+};
+
+//Settings for a multi-node cluster simulation
+struct cluster_config
+{
+	int node_count; //Number of nodes in the cluster
+	int processor_count; //Number of processors in each node
+	long long num_jobs; //Number of jobs sent through the dispatcher
+	dispatch_policy policy; //Policy the dispatcher uses to choose a node for each job
+	long long dispatch_latency; //Cycles between the dispatcher receiving a job and the job arriving at its node
+	workload_config workload; //Arrival and burst models for the jobs (the load factor is measured against every processor in the cluster)
+	string output_file; //Name of the output file
+};
+
+//State of one node in the cluster: a multi-processor SJF system with its own process queue
+struct cluster_node
+{
+	priority_queue<ready_job, vector<ready_job>, shortest_job_first> process_queue; //Jobs that have arrived at the node and are waiting for a processor
+	int idle_processors; //Number of processors that are not executing a job
+	int jobs_in_system; //Jobs sent to the node that have not finished yet (including jobs still on their way from the dispatcher)
+	long long queued_cycles; //CPU cycles of the jobs sent to the node that have not started yet (including jobs still on their way from the dispatcher)
+	long long stop_time_sum; //Sum of the stop times of the currently executing jobs
+	long long jobs_completed; //Number of jobs that have finished executing on the node
+	long long busy_cycles; //Total number of cycles the node's processors spent executing jobs
+};
+
+//Event in the cluster simulation: a job arriving at a node (from the dispatcher) or a job finishing on a node
+struct cluster_event
+{
+	long long time;
+	int type; //0 = the job arrives at the node, 1 = the job finishes executing on the node
+	int node_index;
+	ready_job job;
+};
+
+//Orders cluster events by time so the earliest event is on top of a priority_queue
+//Arrivals come before completions at the same time (so a freed processor can choose from every job that has arrived), and shorter jobs arrive first
+struct cluster_event_order
+{
+	bool operator()(const cluster_event &a, const cluster_event &b) const
+	{
+		if(a.time != b.time)
+		{
+			return a.time > b.time;
+		}
+		
+		if(a.type != b.type)
+		{
+			return a.type > b.type;
+		}
+		
+		return shortest_job_first()(a.job, b.job);
+	}
+};
+
+typedef priority_queue<cluster_event, vector<cluster_event>, cluster_event_order> cluster_event_queue;
+
+//Returns the name of a dispatching policy (used for output)
+string dispatch_policy_name(dispatch_policy policy)
+{
+	switch(policy)
+	{
+		case DISPATCH_LEAST_WORK_LEFT:
+			return "Least Work Left";
+		case DISPATCH_POWER_OF_TWO:
+			return "Power of Two Choices";
+		default:
+			return "Join the Shortest Queue";
+	}
+}
+
+//Starts executing a job on one of a node's idle processors and schedules the event for when the job finishes
+void start_cluster_job(cluster_node &current_node, int node_index, const ready_job &job, long long current_time, cluster_event_queue &events, vector<long long> &waiting_times)
+{
+	current_node.idle_processors--;
+	current_node.queued_cycles -= job.CPU_cycles;
+	current_node.stop_time_sum += current_time + job.CPU_cycles;
+	current_node.busy_cycles += job.CPU_cycles;
+	
+	waiting_times[job.process_ID - 1] = current_time - job.arrival_time; //Waiting time is measured from when the dispatcher received the job
+	
+	cluster_event finish = {current_time + job.CPU_cycles, 1, node_index, job};
+	events.push(finish);
+}
+
+//Handles a single cluster event (a job arriving at its node or a job finishing on its node)
+void process_cluster_event(vector<cluster_node> &nodes, const cluster_event &event, cluster_event_queue &events, vector<long long> &waiting_times)
+{
+	cluster_node &current_node = nodes[event.node_index];
+	
+	//If the job is arriving at the node: Execute it on an idle processor or add it to the node's process queue
+	//Else: Free the job's processor and execute the shortest job waiting in the node's process queue
+	if(event.type == 0)
+	{
+		if(current_node.idle_processors > 0)
+		{
+			start_cluster_job(current_node, event.node_index, event.job, event.time, events, waiting_times);
+		}
+		else
+		{
+			current_node.process_queue.push(event.job);
+		}
+	}
+	else
+	{
+		current_node.idle_processors++;
+		current_node.stop_time_sum -= event.time;
+		current_node.jobs_in_system--;
+		current_node.jobs_completed++;
+		
+		if(!current_node.process_queue.empty())
+		{
+			ready_job next_job = current_node.process_queue.top();
+			current_node.process_queue.pop();
+			
+			start_cluster_job(current_node, event.node_index, next_job, event.time, events, waiting_times);
+		}
+	}
+}
+
+//Chooses the node that receives the next job based on the dispatching policy
+//scan_start rotates through the nodes so ties are not always broken in favor of the first node
+int dispatch_job(const vector<cluster_node> &nodes, const cluster_config &config, long long current_time, mt19937 &randomNum_generator, uniform_int_distribution<int> &node_distribution, int &scan_start)
+{
+	int node_count = nodes.size();
+	int best_index = 0;
+	
+	if(config.policy == DISPATCH_POWER_OF_TWO)
+	{
+		int first = node_distribution(randomNum_generator);
+		int second = node_distribution(randomNum_generator);
+		
+		//Makes sure two different nodes are sampled (if there is more than one node)
+		while(second == first && node_count > 1)
+		{
+			second = node_distribution(randomNum_generator);
+		}
+		
+		best_index = (nodes[second].jobs_in_system < nodes[first].jobs_in_system) ? second : first;
+	}
+	else
+	{
+		long long best_value = LLONG_MAX, value = 0;
+		
+		//Loop through every node to find the node with the least work left (or the fewest jobs)
+		for(int count = 0, index = scan_start; count < node_count; count++, index++)
+		{
+			if(index == node_count)
+			{
+				index = 0;
+			}
+			
+			if(config.policy == DISPATCH_LEAST_WORK_LEFT)
+			{
+				int busy_processors = config.processor_count - nodes[index].idle_processors;
+				
+				value = nodes[index].queued_cycles + nodes[index].stop_time_sum - busy_processors * current_time; //Cycles waiting to start plus cycles left on the executing jobs
+			}
+			else
+			{
+				value = nodes[index].jobs_in_system;
+			}
+			
+			if(value < best_value)
+			{
+				best_value = value;
+				best_index = index;
+			}
+		}
+		
+		scan_start = (scan_start + 1 == node_count) ? 0 : scan_start + 1;
+	}
+	
+	return best_index;
+}
+
+//Runs the cluster simulation for config.num_jobs jobs, handed out in arrival order by next_job(job index) with process IDs 1 - num_jobs
+//Stores the final state of every node and the waiting time of every job (indexed by process ID - 1), and returns the time the last job finished
+long long simulate_cluster(const cluster_config &config, const function<ready_job(long long)> &next_job, vector<cluster_node> &nodes, vector<long long> &waiting_times)
+{
+	//Declares and initializes every node in the cluster (all processors start idle)
+	nodes.assign(config.node_count, cluster_node());
+	
+	for(int index = 0; index < config.node_count; index++)
+	{
+		nodes[index].idle_processors = config.processor_count;
+		nodes[index].jobs_in_system = 0;
+		nodes[index].queued_cycles = 0;
+		nodes[index].stop_time_sum = 0;
+		nodes[index].jobs_completed = 0;
+		nodes[index].busy_cycles = 0;
+	}
+	
+	waiting_times.assign(config.num_jobs, 0);
+	
+	cluster_event_queue events; //Pending arrivals at nodes and job completions, earliest first
+	
+	//Declares variables for random number generation for the dispatcher (kept separate from the workload so every policy sees the same jobs for the same seed)
+	mt19937 randomNum_generator(config.workload.seed + 1);
+	uniform_int_distribution<int> node_distribution(0, config.node_count - 1);
+	
+	int scan_start = 0;
+	long long current_time = 0;
+	
+	//Loop used to send each job through the dispatcher in arrival order
+	for(long long job_index = 0; job_index < config.num_jobs; job_index++)
+	{
+		ready_job job = next_job(job_index);
+		
+		//Handles every event before the job's arrival so the dispatcher sees the current state of every node
+		//(events at the arrival time itself wait until every job arriving at that time has been dispatched, so with a dispatch latency of 0
+		//the node still handles all of that time's arrivals before its completions, and a freed processor can choose from every job that has arrived)
+		while(!events.empty() && events.top().time < job.arrival_time)
+		{
+			cluster_event event = events.top();
+			events.pop();
+			
+			process_cluster_event(nodes, event, events, waiting_times);
+		}
+		
+		current_time = job.arrival_time;
+		
+		int node_index = dispatch_job(nodes, config, current_time, randomNum_generator, node_distribution, scan_start);
+		
+		//The dispatcher counts the job against the node right away, even though it arrives at the node after the dispatch latency
+		nodes[node_index].jobs_in_system++;
+		nodes[node_index].queued_cycles += job.CPU_cycles;
+		
+		cluster_event arrival = {current_time + config.dispatch_latency, 0, node_index, job};
+		events.push(arrival);
+	}
+	
+	//Handles the remaining events after the last job has been dispatched
+	while(!events.empty())
+	{
+		cluster_event event = events.top();
+		events.pop();
+		
+		current_time = event.time;
+		
+		process_cluster_event(nodes, event, events, waiting_times);
+	}
+	
+	return current_time;
+}
+
+//Runs a multi-node cluster simulation: a front-end dispatcher assigns each arriving job to a node, and each node schedules its jobs using multi-processor SJF
+void SJF_cluster(const cluster_config &config)
+{
+	ofstream sjf_file(config.output_file.c_str()); //Declares an output file stream for the cluster simulation output
+	
+	//Runs the cluster simulation if the file has been opened without errors
+	if (!sjf_file.is_open())
+	{
+		cout<<"Unable to open the SJF (Shortest Job First) output file for a cluster.";
+		return;
+	}
+	
+	chrono::steady_clock::time_point start_clock = chrono::steady_clock::now(); //Used to report how long the simulation took to run
+	
+	//Declares the generator for the jobs' CPU cycles and arrival times (the load factor covers every processor in the cluster)
+	workload_config workload = config.workload;
+	workload.processor_count = config.node_count * config.processor_count;
+	
+	workload_generator generator;
+	init_workload_generator(generator, workload);
+	
+	vector<cluster_node> nodes;
+	vector<long long> waiting_times; //Waiting time of every job (indexed by process ID - 1)
+	
+	long long total_cycles_cluster = 0;
+	
+	//Generates each job as the dispatcher needs it
+	long long current_time = simulate_cluster(config, [&](long long job_index) {
+		ready_job job;
+		job.process_ID = job_index + 1;
+		job.CPU_cycles = generate_burst(generator);
+		job.arrival_time = generate_arrival(generator);
+		job.deadline = NO_DEADLINE;
+		
+		total_cycles_cluster += job.CPU_cycles;
+		
+		return job;
+	}, nodes, waiting_times);
+	
+	double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_clock).count();
+	
+	long long makespan = (current_time > 0) ? current_time : 1; //Time the last job finished
+	
+	//Calculates the per-node load distribution (jobs per node and processor utilization per node)
+	double mean_jobs = 0, jobs_variance = 0, mean_utilization = 0;
+	long long min_jobs = LLONG_MAX, max_jobs = 0;
+	double min_utilization = 1, max_utilization = 0;
+	
+	//Prints headers for output
+	sjf_file<<"SJF (Shortest Job First) Cluster Simulation ("<<dispatch_policy_name(config.policy)<<" Dispatching):"<<endl<<endl;
+	sjf_file<<"Nodes = "<<config.node_count<<", Processors per Node = "<<config.processor_count<<", Jobs = "<<config.num_jobs
+			<<", Dispatch Latency = "<<config.dispatch_latency<<((workload.load_factor > 0) ? ", Load Factor = " : ", Spacing = ")<<((workload.load_factor > 0) ? workload.load_factor : workload.arrival_spacing)
+			<<", Arrivals = "<<arrival_model_name(workload.arrivals)<<", Bursts = "<<(workload.bursts == BURST_PARETO ? "Pareto" : "Normal")<<", Seed = "<<workload.seed<<endl<<endl;
+	sjf_file<<"Node\t\t"
+			<<"Jobs Completed\t"
+			<<"Busy Cycles\t"
+			<<"Utilization"<<endl;
+	sjf_file<<"------------------------------------------------------------"<<endl;
+	
+	//Loop through the nodes to print each node's load and accumulate the load distribution
+	for(int index = 0; index < config.node_count; index++)
+	{
+		double utilization = (double)nodes[index].busy_cycles / ((double)config.processor_count * makespan);
+		
+		sjf_file<<setw(12)<<left<<"Node " + to_string(index+1) + ":"<<"\t"
+				<<setw(14)<<right<<nodes[index].jobs_completed<<"\t"
+				<<setw(11)<<nodes[index].busy_cycles<<"\t"
+				<<setw(11)<<fixed<<setprecision(4)<<utilization<<endl;
+		
+		mean_jobs += nodes[index].jobs_completed;
+		mean_utilization += utilization;
+		min_jobs = min(min_jobs, nodes[index].jobs_completed);
+		max_jobs = max(max_jobs, nodes[index].jobs_completed);
+		min_utilization = min(min_utilization, utilization);
+		max_utilization = max(max_utilization, utilization);
+	}
+	
+	mean_jobs /= config.node_count;
+	mean_utilization /= config.node_count;
+	
+	for(int index = 0; index < config.node_count; index++)
+	{
+		jobs_variance += (nodes[index].jobs_completed - mean_jobs) * (nodes[index].jobs_completed - mean_jobs);
+	}
+	
+	jobs_variance /= config.node_count;
+	
+	//Calculates the global average waiting time and waiting time percentiles
+	double avg_waiting_time = 0;
+	
+	for(long long job_index = 0; job_index < config.num_jobs; job_index++)
+	{
+		avg_waiting_time += waiting_times[job_index];
+	}
+	
+	avg_waiting_time /= (config.num_jobs > 0) ? config.num_jobs : 1;
+	
+	long long p50 = percentile(waiting_times, 50), p90 = percentile(waiting_times, 90), p99 = percentile(waiting_times, 99), p999 = percentile(waiting_times, 99.9), max_wait = percentile(waiting_times, 100);
+	
+	//Prints the summary to the output file and to the screen
+	for(int output = 0; output < 2; output++)
+	{
+		ostream &out = (output == 0) ? (ostream&)sjf_file : cout;
+		
+		out<<endl;
+		out<<fixed<<setprecision(2);
+		out<<"Cluster Simulation ("<<dispatch_policy_name(config.policy)<<" Dispatching): "<<config.num_jobs<<" jobs on "<<config.node_count<<" nodes x "<<config.processor_count<<" processors"<<endl;
+		out<<"Jobs per Node: Mean = "<<mean_jobs<<", Min = "<<min_jobs<<", Max = "<<max_jobs<<", Standard Deviation = "<<sqrt(jobs_variance)<<endl;
+		out<<"Node Utilization: Mean = "<<mean_utilization<<", Min = "<<min_utilization<<", Max = "<<max_utilization<<endl;
+		out<<"Average Waiting Time = "<<avg_waiting_time<<endl;
+		out<<"Waiting Time Percentiles: p50 = "<<p50<<", p90 = "<<p90<<", p99 = "<<p99<<", p99.9 = "<<p999<<", Max = "<<max_wait<<endl;
+		out<<"Total Cycles = "<<total_cycles_cluster<<", Makespan = "<<makespan<<endl;
+		out<<"Simulation Time = "<<elapsed_seconds<<" seconds"<<endl;
+	}
+	
+	sjf_file.close(); //Closes the output file
+}
+
+//One performance state (P-state) of a processor: how fast it executes CPU cycles and the power it draws while executing
+struct p_state
+{
+	double cycle_rate; //CPU cycles executed per time unit (1 = full speed, where a process takes as many time units as it has CPU cycles)
+	double power; //Energy used per time unit while executing (1 = the power of a full speed processor)
+};
+
+//Power model of one processor: its P-states (fastest first) and the power it draws while idle
+//An idle processor stays awake for sleep_after time units and then drops to its low-power sleep state
+struct processor_power
+{
+	vector<p_state> p_states;
+	double idle_power; //Energy used per time unit while idle and awake (ready to start a process right away)
+	double sleep_power; //Energy used per time unit in the sleep state
+	long long sleep_after; //Time units an idle processor stays awake before it goes to sleep
+	long long wake_latency; //Time units a sleeping processor needs to wake up before it can start a process (drawing idle power)
+};
+
+//Frequency policies (how energy mode chooses the P-state each process runs at)
+enum dvfs_policy
+{
+	DVFS_RACE_TO_IDLE, //Every process runs at the fastest P-state, so processors finish early and sleep
+	DVFS_SLACK //A short process runs at the P-state that uses the least energy while still meeting its deadline (only when no other process is waiting for a processor)
+};
+
+//Settings for an energy simulation
+struct energy_config
+{
+	int processor_count;
+	scheduling_policy policy;
+	double aging_rate;
+	vector<processor_power> processors; //Power model of each processor
+	int short_cycles; //Processes with at most this many CPU cycles are short
+	double deadline_stretch; //A short process with no deadline of its own gets its arrival time plus deadline_stretch times its CPU cycles
+	string output_file;
+};
+
+//Energy used by one processor in an energy simulation
+struct processor_energy
+{
+	vector<long long> p_state_time; //Time units spent executing in each P-state
+	long long idle_time; //Time units spent idle and awake
+	long long sleep_time; //Time units spent in the sleep state
+	long long wakeups;
+	long long jobs_completed;
+	double energy; //Total energy used (executing, idle, asleep, and waking up)
+};
+
+//Schedule of one process in an energy simulation
+struct energy_entry
+{
+	long long start_time; //Time the process starts executing (after its processor wakes up, if it was asleep)
+	long long stop_time;
+	int processor;
+	int p_state;
+	double energy; //Energy used to execute the process
+};
+
+//Returns the name of a frequency policy (used for output)
+string dvfs_policy_name(dvfs_policy policy)
+{
+	return (policy == DVFS_RACE_TO_IDLE) ? "Race to Idle" : "Slack DVFS";
+}
+
+//Returns the deadline slack DVFS uses for a short process: its own deadline, or its arrival time plus deadline_stretch times its CPU cycles if it has none
+long long energy_deadline(const ready_job &job, const energy_config &config)
+{
+	return (job.deadline != NO_DEADLINE) ? job.deadline : job.arrival_time + (long long)(config.deadline_stretch * job.CPU_cycles);
+}
+
+//Returns the time units a process takes to execute at a P-state
+long long p_state_run_time(int CPU_cycles, const p_state &state)
+{
+	return (long long)ceil(CPU_cycles / state.cycle_rate);
+}
+
+//Adds the energy a processor uses while idle for idle_time time units (awake for up to sleep_after time units, then asleep)
+//Returns true if the processor fell asleep
+bool add_idle_energy(const processor_power &power, processor_energy &usage, long long idle_time)
+{
+	long long awake_time = min(idle_time, power.sleep_after);
+	
+	usage.idle_time += awake_time;
+	usage.sleep_time += idle_time - awake_time;
+	usage.energy += awake_time * power.idle_power + (idle_time - awake_time) * power.sleep_power;
+	
+	return idle_time > power.sleep_after;
+}
+
+//Schedules a set of jobs (in arrival order, with process IDs 1 - jobs.size()) on processors with P-states, using the scheduling policy to choose the next process
+//and a frequency policy to choose the P-state it runs at. Non-preemptive, like schedule_jobs
+//Out of the idle processors, the one that went idle most recently takes the next process, so the processors that have been idle longest can stay asleep
+//(processors go idle in time order, so the idle processors form a stack). Stores the schedule for each process at index process ID - 1 and the energy
+//used by each processor, and returns the time the last process finished
+long long schedule_energy_jobs(const vector<ready_job> &jobs, const energy_config &config, dvfs_policy dvfs, vector<energy_entry> &schedule, vector<processor_energy> &usage)
+{
+	int num_processes = jobs.size();
+	
+	schedule.resize(num_processes);
+	usage.assign(config.processor_count, processor_energy());
+	
+	for(int index = 0; index < config.processor_count; index++)
+	{
+		usage[index].p_state_time.assign(config.processors[index].p_states.size(), 0);
+	}
+	
+	policy_queue ready;
+	init_policy_queue(ready, config.policy, config.aging_rate);
+	
+	//Keeps track of the time each busy processor becomes free, earliest first
+	priority_queue< pair<long long, int>, vector< pair<long long, int> >, greater< pair<long long, int> > > busy_processors;
+	
+	vector< pair<long long, int> > idle_processors; //(Time the processor went idle, processor index), most recently idle last
+	
+	for(int index = config.processor_count - 1; index >= 0; index--)
+	{
+		idle_processors.push_back(make_pair(0LL, index));
+	}
+	
+	long long current_time = 0, makespan = 0;
+	int next_arrival = 0, scheduled = 0;
+	
+	//Loop used to hand a process to an idle processor until every process has been scheduled
+	while(scheduled < num_processes)
+	{
+		//Moves the processors that have finished by the current time to the idle processors
+		while(!busy_processors.empty() && busy_processors.top().first <= current_time)
+		{
+			idle_processors.push_back(busy_processors.top());
+			busy_processors.pop();
+		}
+		
+		//Adds every process that has arrived by the current time to the process queue
+		while(next_arrival < num_processes && jobs[next_arrival].arrival_time <= current_time)
+		{
+			push_policy_queue(ready, jobs[next_arrival]);
+			
+			next_arrival++;
+		}
+		
+		//If every processor is busy: Skips ahead to the time the next processor becomes free
+		if(idle_processors.empty())
+		{
+			current_time = busy_processors.top().first;
+			continue;
+		}
+		
+		//If no processes are waiting: Skips ahead to the time the next process arrives
+		if(ready.size == 0)
+		{
+			current_time = jobs[next_arrival].arrival_time;
+			continue;
+		}
+		
+		int processor = idle_processors.back().second;
+		long long start_time = current_time;
+		
+		const processor_power &power = config.processors[processor];
+		processor_energy &processor_usage = usage[processor];
+		
+		//If the processor fell asleep while it was idle: It has to wake up before the process can start
+		if(add_idle_energy(power, processor_usage, current_time - idle_processors.back().first))
+		{
+			start_time += power.wake_latency;
+			processor_usage.idle_time += power.wake_latency;
+			processor_usage.energy += power.wake_latency * power.idle_power;
+			processor_usage.wakeups++;
+		}
+		
+		idle_processors.pop_back();
+		
+		ready_job job = pop_policy_queue(ready, current_time);
+		
+		int state = 0;
+		
+		//If the process is short and nothing else is waiting: Runs it at the P-state that uses the least energy while still meeting its deadline
+		//(ties go to the faster P-state, and if no P-state meets the deadline the process runs at full speed)
+		if(dvfs == DVFS_SLACK && job.CPU_cycles <= config.short_cycles && ready.size == 0)
+		{
+			long long deadline = energy_deadline(job, config);
+			
+			for(int index = 1; index < (int)power.p_states.size(); index++)
+			{
+				long long run_time = p_state_run_time(job.CPU_cycles, power.p_states[index]);
+				
+				if(start_time + run_time <= deadline && run_time * power.p_states[index].power < p_state_run_time(job.CPU_cycles, power.p_states[state]) * power.p_states[state].power)
+				{
+					state = index;
+				}
+			}
+		}
+		
+		long long run_time = p_state_run_time(job.CPU_cycles, power.p_states[state]);
+		
+		energy_entry &entry = schedule[job.process_ID - 1];
+		entry.start_time = start_time;
+		entry.stop_time = start_time + run_time;
+		entry.processor = processor;
+		entry.p_state = state;
+		entry.energy = run_time * power.p_states[state].power;
+		
+		processor_usage.p_state_time[state] += run_time;
+		processor_usage.energy += entry.energy;
+		processor_usage.jobs_completed++;
+		
+		busy_processors.push(make_pair(entry.stop_time, processor));
+		
+		makespan = max(makespan, entry.stop_time);
+		scheduled++;
+	}
+	
+	//Adds the energy every processor uses while idle from the time it finished its last process to the time the last process finished
+	while(!busy_processors.empty())
+	{
+		idle_processors.push_back(busy_processors.top());
+		busy_processors.pop();
+	}
+	
+	for(size_t index = 0; index < idle_processors.size(); index++)
+	{
+		int processor = idle_processors[index].second;
+		
+		add_idle_energy(config.processors[processor], usage[processor], makespan - idle_processors[index].first);
+	}
+	
+	return makespan;
+}
+
+//Runs the jobs with each frequency policy (race to idle and slack DVFS) and compares the energy used against the waiting times
+//Writes the time spent in each P-state and the energy used by every processor to the output file, followed by the summary for each policy:
+//waiting time, short process deadline misses, energy per process, and energy-delay product (EDP)
+void SJF_energy(const vector<ready_job> &jobs, const energy_config &config)
+{
+	ofstream sjf_file(config.output_file.c_str()); //Declares an output file stream for the energy simulation output
+	
+	//Runs the energy simulation if the file has been opened without errors
+	if (!sjf_file.is_open())
+	{
+		cout<<"Unable to open the SJF (Shortest Job First) output file for energy mode.";
+		return;
+	}
+	
+	int num_processes = jobs.size();
+	
+	//Prints headers for output
+	sjf_file<<"SJF (Shortest Job First) Energy Simulation ("<<scheduling_policy_name(config.policy)<<"):"<<endl<<endl;
+	sjf_file<<"Processes = "<<num_processes<<", Processors = "<<config.processor_count<<", Short Processes = at most "<<config.short_cycles<<" CPU cycles"
+			<<", Short Process Deadline = its own deadline, or arrival time + "<<config.deadline_stretch<<" x CPU cycles"<<endl;
+	sjf_file<<"P-states (CPU cycles per time unit / power):";
+	
+	for(size_t index = 0; index < config.processors[0].p_states.size(); index++)
+	{
+		sjf_file<<" P"<<index<<" = "<<config.processors[0].p_states[index].cycle_rate<<" / "<<config.processors[0].p_states[index].power;
+	}
+	
+	sjf_file<<endl<<"Idle Power = "<<config.processors[0].idle_power<<", Sleep Power = "<<config.processors[0].sleep_power<<" (after "<<config.processors[0].sleep_after
+			<<" idle time units), Wake-up Latency = "<<config.processors[0].wake_latency<<endl;
+	
+	for(int run = 0; run < 2; run++)
+	{
+		dvfs_policy dvfs = (dvfs_policy)run;
+		
+		vector<energy_entry> schedule;
+		vector<processor_energy> usage;
+		
+		long long makespan = schedule_energy_jobs(jobs, config, dvfs, schedule, usage);
+		
+		sjf_file<<endl<<dvfs_policy_name(dvfs)<<":"<<endl<<endl;
+		sjf_file<<"Processor\tProcesses\t";
+		
+		for(size_t index = 0; index < config.processors[0].p_states.size(); index++)
+		{
+			sjf_file<<"P"<<index<<" Time\t\t";
+		}
+		
+		sjf_file<<"Idle Time\tSleep Time\tWake-ups\tEnergy"<<endl;
+		sjf_file<<"--------------------------------------------------------------------------------------------------------------------------------"<<endl;
+		
+		double total_energy = 0;
+		
+		//Loop through the processors to print the time each one spent in each state and the energy it used
+		for(int processor = 0; processor < config.processor_count; processor++)
+		{
+			sjf_file<<setw(12)<<left<<"Processor " + to_string(processor+1)<<"\t"<<setw(9)<<right<<usage[processor].jobs_completed<<"\t";
+			
+			for(size_t index = 0; index < usage[processor].p_state_time.size(); index++)
+			{
+				sjf_file<<setw(12)<<usage[processor].p_state_time[index]<<"\t";
+			}
+			
+			sjf_file<<setw(12)<<usage[processor].idle_time<<"\t"<<setw(12)<<usage[processor].sleep_time<<"\t"<<setw(8)<<usage[processor].wakeups<<"\t"
+					<<fixed<<setprecision(0)<<usage[processor].energy<<endl;
+			
+			total_energy += usage[processor].energy;
+		}
+		
+		//Calculates the waiting times, deadline misses, and energy-delay products of the processes
+		vector<long long> waits(num_processes);
+		double avg_waiting_time = 0, execution_energy = 0, avg_job_EDP = 0;
+		long long short_processes = 0, deadline_misses = 0, slowed_processes = 0;
+		
+		for(int i = 0; i < num_processes; i++)
+		{
+			const energy_entry &entry = schedule[jobs[i].process_ID - 1];
+			
+			waits[i] = entry.start_time - jobs[i].arrival_time;
+			avg_waiting_time += waits[i];
+			execution_energy += entry.energy;
+			avg_job_EDP += entry.energy * (entry.stop_time - jobs[i].arrival_time); //Energy used by the process times its response time
+			slowed_processes += (entry.p_state > 0) ? 1 : 0;
+			
+			if(jobs[i].CPU_cycles <= config.short_cycles)
+			{
+				short_processes++;
+				deadline_misses += (entry.stop_time > energy_deadline(jobs[i], config)) ? 1 : 0;
+			}
+		}
+		
+		avg_waiting_time /= num_processes;
+		avg_job_EDP /= num_processes;
+		
+		long long p99 = percentile(waits, 99), max_wait = percentile(waits, 100);
+		
+		//Prints the summary to the output file and to the screen
+		for(int output = 0; output < 2; output++)
+		{
+			ostream &out = (output == 0) ? (ostream&)sjf_file : cout;
+			
+			out<<endl;
+			out<<fixed<<setprecision(2);
+			out<<dvfs_policy_name(dvfs)<<" ("<<num_processes<<" processes on "<<config.processor_count<<" processors, "<<slowed_processes<<" run below full speed):"<<endl;
+			out<<"Average Waiting Time = "<<avg_waiting_time<<", p99 Waiting Time = "<<p99<<", Max Waiting Time = "<<max_wait<<endl;
+			out<<"Short Process Deadline Misses = "<<deadline_misses<<" of "<<short_processes<<endl;
+			out<<"Total Energy = "<<total_energy<<" (Executing = "<<execution_energy<<", Idle/Asleep = "<<total_energy - execution_energy<<"), Makespan = "<<makespan<<endl;
+			out<<"Energy per Process = "<<total_energy / num_processes<<", Average Process EDP (energy x response time) = "<<avg_job_EDP
+			   <<", System EDP (total energy x makespan) = "<<scientific<<setprecision(4)<<total_energy * makespan<<fixed<<endl;
+		}
+	}
+	
+	sjf_file.close(); //Closes the output file
+}
+
+//Runs every scheduling policy with and without admission control on a set of jobs (in arrival order, with process IDs 1 - jobs.size()) that have deadlines
+//Writes the rejections, deadline misses, lateness percentiles (stop time - deadline, negative when a process finishes early), average waiting time, and the
+//time each schedule took to compute, to the output file and the screen
+void SJF_deadline(const vector<ready_job> &jobs, int processor_count, double aging_rate, const string &output_file)
+{
+	ofstream sjf_file(output_file.c_str()); //Declares an output file stream for the deadline output
+	
+	//Runs the deadline comparison if the file has been opened without errors
+	if (!sjf_file.is_open())
+	{
+		cout<<"Unable to open the SJF (Shortest Job First) output file for deadline mode.";
+		return;
+	}
+	
+	int num_processes = jobs.size();
+	long long deadline_processes = 0;
+	
+	for(int i = 0; i < num_processes; i++)
+	{
+		deadline_processes += (jobs[i].deadline != NO_DEADLINE) ? 1 : 0;
+	}
+	
+	//Prints headers for output
+	for(int output = 0; output < 2; output++)
+	{
+		ostream &out = (output == 0) ? (ostream&)sjf_file : cout;
+		
+		out<<"Deadline Scheduling ("<<num_processes<<" processes on "<<processor_count<<" processors, "<<deadline_processes<<" with deadlines):"<<endl;
+		out<<"Admission control uses an estimated finish time (later arrivals that run first and uneven processor loads are not counted), so admitted processes can still miss."<<endl<<endl;
+		out<<"Policy\t\t\tAdmission\tRejected\tMissed\t\tMiss Rate\tLateness p50\tp90\t\tp99\t\tp99.9\t\tMax\t\tAverage Wait\tSeconds\t\tProcesses/Second"<<endl;
+		out<<"----------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------"<<endl;
+	}
+	
+	const scheduling_policy policies[5] = {POLICY_SJF, POLICY_AGING, POLICY_HRRN, POLICY_EDF, POLICY_SJF_FEASIBLE};
+	
+	for(int index = 0; index < 5; index++)
+	{
+		for(int admission = 0; admission < 2; admission++)
+		{
+			vector<schedule_entry> schedule;
+			
+			chrono::steady_clock::time_point start_clock = chrono::steady_clock::now();
+			
+			schedule_jobs(jobs, processor_count, policies[index], aging_rate, admission == 1, schedule);
+			
+			double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_clock).count();
+			
+			//Calculates the rejections, misses, and lateness of the processes with deadlines, and the average waiting time of the processes that executed
+			vector<long long> lateness;
+			long long rejected = 0, missed = 0, executed = 0;
+			double avg_waiting_time = 0;
+			
+			for(int i = 0; i < num_processes; i++)
+			{
+				const schedule_entry &entry = schedule[jobs[i].process_ID - 1];
+				
+				if(entry.rejected)
+				{
+					rejected++;
+					continue;
+				}
+				
+				executed++;
+				avg_waiting_time += entry.start_time - jobs[i].arrival_time;
+				
+				if(jobs[i].deadline != NO_DEADLINE)
+				{
+					lateness.push_back(entry.stop_time - jobs[i].deadline);
+					missed += (entry.stop_time > jobs[i].deadline) ? 1 : 0;
+				}
+			}
+			
+			avg_waiting_time /= (executed > 0) ? executed : 1;
+			
+			double miss_rate = lateness.empty() ? 0 : (double)missed / lateness.size(); //Out of the processes with deadlines that executed
+			
+			long long p50 = percentile(lateness, 50), p90 = percentile(lateness, 90), p99 = percentile(lateness, 99), p999 = percentile(lateness, 99.9), max_lateness = percentile(lateness, 100);
+			
+			//Prints the results to the output file and to the screen
+			for(int output = 0; output < 2; output++)
+			{
+				ostream &out = (output == 0) ? (ostream&)sjf_file : cout;
+				
+				out<<setw(16)<<left<<scheduling_policy_name(policies[index])<<"\t"<<setw(9)<<(admission == 1 ? "On" : "Off")<<"\t"
+				   <<setw(8)<<right<<rejected<<"\t"<<setw(8)<<missed<<"\t"<<setw(8)<<fixed<<setprecision(2)<<miss_rate * 100<<"%\t"
+				   <<setw(12)<<p50<<"\t"<<setw(8)<<p90<<"\t"<<setw(8)<<p99<<"\t"<<setw(8)<<p999<<"\t"<<setw(8)<<max_lateness<<"\t"
+				   <<setw(12)<<avg_waiting_time<<"\t"<<setw(8)<<setprecision(4)<<elapsed_seconds<<"\t"<<setw(16)<<setprecision(0)<<num_processes / max(elapsed_seconds, 1e-9)<<endl;
+			}
+		}
+	}
+	
+	sjf_file.close(); //Closes the output file
+}
+
+//Output file that collects output in a large buffer and writes it in big blocks (much faster than writing every value with <<)
+struct buffered_writer
+{
+	ofstream file;
+	vector<char> buffer;
+	size_t used; //Number of bytes in the buffer
+	long long bytes_written; //Total number of bytes written to the file
+};
+
+//Opens a buffered writer for a file, returns false if the file cannot be opened
+bool open_writer(buffered_writer &writer, const string &file_name)
+{
+	writer.file.open(file_name.c_str(), ios::out | ios::binary);
+	writer.buffer.resize(1 << 20); //1 MB buffer
+	writer.used = 0;
+	writer.bytes_written = 0;
+	
+	return writer.file.is_open();
+}
+
+//Writes the contents of the buffer to the file
+void flush_writer(buffered_writer &writer)
+{
+	writer.file.write(writer.buffer.data(), writer.used);
+	writer.bytes_written += writer.used;
+	writer.used = 0;
+}
+
+//Adds bytes to the buffer (flushing the buffer to the file first if they do not fit)
+void write_bytes(buffered_writer &writer, const void *data, size_t size)
+{
+	if(writer.used + size > writer.buffer.size())
+	{
+		flush_writer(writer);
+		
+		//If the data is larger than the whole buffer: Write it to the file directly
+		if(size > writer.buffer.size())
+		{
+			writer.file.write((const char*)data, size);
+			writer.bytes_written += size;
+			return;
+		}
+	}
+	
+	memcpy(writer.buffer.data() + writer.used, data, size);
+	writer.used += size;
+}
+
+//Adds text to the buffer
+void write_text(buffered_writer &writer, const string &text)
+{
+	write_bytes(writer, text.data(), text.size());
+}
+
+//Adds a whole number to the buffer as text
+void write_number(buffered_writer &writer, long long number)
+{
+	char digits[24];
+	int position = sizeof(digits);
+	bool negative = number < 0;
+	unsigned long long value = negative ? 0ULL - (unsigned long long)number : number;
+	
+	//Fills in the digits from right to left
+	do
+	{
+		digits[--position] = '0' + value % 10;
+		value /= 10;
+	} while(value > 0);
+	
+	if(negative)
+	{
+		digits[--position] = '-';
+	}
+	
+	write_bytes(writer, digits + position, sizeof(digits) - position);
+}
+
+//Writes the rest of the buffer and closes the file, returns false if anything could not be written
+bool close_writer(buffered_writer &writer)
+{
+	flush_writer(writer);
+	writer.file.close();
+	
+	return !writer.file.fail();
+}
+
+//Formats for the timeline export
+enum timeline_format
+{
+	TIMELINE_JSON, //Chrome trace-event JSON (opens in chrome://tracing, Perfetto, and other profiler-style viewers)
+	TIMELINE_BINARY //Columnar binary: a header followed by one column at a time
+};
+
+//One interval on the timeline: a processor executing a process (or, when downsampled, a run of back-to-back processes) from start to stop
+struct timeline_interval
+{
+	int processor;
+	int process_ID; //Process ID of the first process in the interval
+	int process_count; //Number of processes merged into the interval (1 unless downsampled)
+	long long start_time;
+	long long stop_time;
+	long long waiting_time; //Waiting time of the first process in the interval
+};
+
+//Builds the timeline intervals for a schedule, ordered by processor and then start time
+//If resolution is greater than 0: Downsamples by merging back-to-back processes on the same processor into intervals of at most resolution cycles
+//(processes longer than the resolution are never merged, so long processes stay visible on their own)
+void build_timeline(const vector<ready_job> &jobs, const vector<schedule_entry> &schedule, long long resolution, vector<timeline_interval> &intervals)
+{
+	vector<int> order(jobs.size()); //Process ID - 1 of every process, ordered by processor and start time
+	
+	for(size_t i = 0; i < order.size(); i++)
+	{
+		order[i] = i;
+	}
+	
+	sort(order.begin(), order.end(), [&](int a, int b) {
+		if(schedule[a].processor != schedule[b].processor)
+		{
+			return schedule[a].processor < schedule[b].processor;
+		}
+		
+		return schedule[a].start_time < schedule[b].start_time;
+	});
+	
+	vector<long long> arrival_times(jobs.size()); //Arrival time of every process (indexed by process ID - 1)
+	
+	for(size_t i = 0; i < jobs.size(); i++)
+	{
+		arrival_times[jobs[i].process_ID - 1] = jobs[i].arrival_time;
+	}
+	
+	intervals.clear();
+	
+	for(size_t i = 0; i < order.size(); i++)
+	{
+		const schedule_entry &entry = schedule[order[i]];
+		
+		//If downsampling and the process starts right where the previous interval on the same processor stops: Merge it in if the interval stays within the resolution
+		if(resolution > 0 && !intervals.empty() && intervals.back().processor == entry.processor && intervals.back().stop_time == entry.start_time &&
+		   entry.stop_time - intervals.back().start_time <= resolution)
+		{
+			intervals.back().stop_time = entry.stop_time;
+			intervals.back().process_count++;
+			continue;
+		}
+		
+		timeline_interval interval = {entry.processor, order[i] + 1, 1, entry.start_time, entry.stop_time, entry.start_time - arrival_times[order[i]]};
+		intervals.push_back(interval);
+	}
+}
+
+//Writes the timeline as Chrome trace-event JSON: one complete ("X") event per interval, with 1 cycle shown as 1 microsecond and one row per processor
+void write_timeline_json(buffered_writer &writer, const vector<timeline_interval> &intervals, int processor_count)
+{
+	write_text(writer, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	write_text(writer, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"SJF Schedule\"}}");
+	
+	//Names each processor's row
+	for(int index = 0; index < processor_count; index++)
+	{
+		write_text(writer, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":");
+		write_number(writer, index + 1);
+		write_text(writer, ",\"args\":{\"name\":\"Processor " + to_string(index + 1) + "\"}}");
+	}
+	
+	for(size_t i = 0; i < intervals.size(); i++)
+	{
+		const timeline_interval &interval = intervals[i];
+		
+		write_text(writer, ",\n{\"name\":\"");
+		
+		//Names the event after its process, or after the number of processes if several were merged by downsampling
+		if(interval.process_count == 1)
+		{
+			write_text(writer, "p");
+			write_number(writer, interval.process_ID);
+		}
+		else
+		{
+			write_number(writer, interval.process_count);
+			write_text(writer, " processes");
+		}
+		
+		write_text(writer, "\",\"ph\":\"X\",\"pid\":1,\"tid\":");
+		write_number(writer, interval.processor + 1);
+		write_text(writer, ",\"ts\":");
+		write_number(writer, interval.start_time);
+		write_text(writer, ",\"dur\":");
+		write_number(writer, interval.stop_time - interval.start_time);
+		write_text(writer, ",\"args\":{\"process\":");
+		write_number(writer, interval.process_ID);
+		write_text(writer, ",\"count\":");
+		write_number(writer, interval.process_count);
+		write_text(writer, ",\"wait\":");
+		write_number(writer, interval.waiting_time);
+		write_text(writer, "}}");
+	}
+	
+	write_text(writer, "\n]}\n");
+}
+
+//Writes the timeline in columnar binary (little-endian on x86/ARM):
+//8 byte magic "SJFTL001", int32 processor count, int32 reserved (0), int64 interval count, then each column in turn:
+//int32 processor[count], int32 process_ID[count], int32 process_count[count], int64 start_time[count], int64 stop_time[count], int64 waiting_time[count]
+void write_timeline_binary(buffered_writer &writer, const vector<timeline_interval> &intervals, int processor_count)
+{
+	int reserved = 0;
+	long long count = intervals.size();
+	
+	write_bytes(writer, "SJFTL001", 8);
+	write_bytes(writer, &processor_count, sizeof(processor_count));
+	write_bytes(writer, &reserved, sizeof(reserved));
+	write_bytes(writer, &count, sizeof(count));
+	
+	for(size_t i = 0; i < intervals.size(); i++)
+	{
+		write_bytes(writer, &intervals[i].processor, sizeof(int));
+	}
+	
+	for(size_t i = 0; i < intervals.size(); i++)
+	{
+		write_bytes(writer, &intervals[i].process_ID, sizeof(int));
+	}
+	
+	for(size_t i = 0; i < intervals.size(); i++)
+	{
+		write_bytes(writer, &intervals[i].process_count, sizeof(int));
+	}
+	
+	for(size_t i = 0; i < intervals.size(); i++)
+	{
+		write_bytes(writer, &intervals[i].start_time, sizeof(long long));
+	}
+	
+	for(size_t i = 0; i < intervals.size(); i++)
+	{
+		write_bytes(writer, &intervals[i].stop_time, sizeof(long long));
+	}
+	
+	for(size_t i = 0; i < intervals.size(); i++)
+	{
+		write_bytes(writer, &intervals[i].waiting_time, sizeof(long long));
+	}
+}
+
+//Exports the timeline of a schedule to a file, returns false if the file cannot be written
+bool export_timeline(const string &file_name, timeline_format format, const vector<ready_job> &jobs, const vector<schedule_entry> &schedule,
+					 int processor_count, long long resolution, long long &interval_count, long long &bytes_written)
+{
+	vector<timeline_interval> intervals;
+	build_timeline(jobs, schedule, resolution, intervals);
+	
+	buffered_writer writer;
+	
+	if(!open_writer(writer, file_name))
+	{
+		return false;
+	}
+	
+	if(format == TIMELINE_JSON)
+	{
+		write_timeline_json(writer, intervals, processor_count);
+	}
+	else
+	{
+		write_timeline_binary(writer, intervals, processor_count);
+	}
+	
+	bool written = close_writer(writer);
+	
+	interval_count = intervals.size();
+	bytes_written = writer.bytes_written;
+	
+	return written;
+}
+
+typedef map< string, vector<string> > option_map; //Option name -> option values (an option with more than one value forms a parameter grid)
+
+//Names of every option that can be set on the command line (--name=value or --name value) or in a config file (name = value)
+const string option_names[] = {"mode", "processes", "processors", "seed", "arrivals", "bursts", "load", "spacing", "policy", "aging-rate",
+							   "pareto-shape", "pareto-min", "pareto-max", "mmpp-ratio", "mmpp-fraction", "mmpp-length", "diurnal-amplitude", "diurnal-period",
+							   "nodes", "dispatch", "latency", "output", "output-prefix", "threads", "timeline-format", "timeline-resolution",
+							   "iterations", "bench-processes", "pstate-rates", "pstate-powers", "idle-power", "sleep-power", "sleep-after", "wake-latency",
+							   "short-cycles", "deadline-stretch", "deadline-fraction", "deadline-min", "deadline-max", "trace-file"};
+
+//Prints the command-line options
+void print_usage()
+{
+	cout<<"Usage: ./'process-scheduler-(sjf)' [trace|batch|cluster|timeline|energy|deadline|fuzz] [--option=value ...] [--config file]"<<endl<<endl;
+	cout<<"Modes:"<<endl;
+	cout<<"  trace    Prints the generated processes and writes the single processor, multi-processor, and policy comparison output files (default)"<<endl;
+	cout<<"  batch    Runs every combination of comma-separated option values and writes one CSV line of waiting times per combination"<<endl;
+	cout<<"  cluster  Runs a multi-node cluster simulation with a front-end dispatcher"<<endl;
+	cout<<"  timeline Schedules the processes with one policy and exports the timeline for a profiler-style viewer (for very large runs)"<<endl;
+	cout<<"  energy   Compares race to idle against slack DVFS (slowing short processes down) on processors with P-states and a sleep state"<<endl;
+	cout<<"  deadline Compares every policy with and without admission control on processes with deadlines (misses, lateness, and scheduling time)"<<endl;
+	cout<<"  fuzz     Checks every scheduling engine against the reference scheduler on random workloads, then benchmarks the engines"<<endl<<endl;
+	cout<<"Options (options marked * accept comma-separated lists in batch mode):"<<endl;
+	cout<<"  --processes=N *        Number of processes (default 50, cluster 10000000, energy 100000, deadline 1000000)"<<endl;
+	cout<<"  --processors=N *       Number of processors (per node in cluster mode) (default 4)"<<endl;
+	cout<<"  --seed=N *             Random number seed (default random)"<<endl;
+	cout<<"  --arrivals=MODEL *     fixed, poisson, mmpp, or diurnal (default fixed)"<<endl;
+	cout<<"  --bursts=MODEL *       normal or pareto (default normal)"<<endl;
+	cout<<"  --load=RHO *           Target load factor, sets the arrival rate (default 0 = use spacing, cluster 0.9, energy 0.6, deadline 0.9,"<<endl;
+	cout<<"                         or 0 in every mode when --spacing is set)"<<endl;
+	cout<<"  --spacing=CYCLES *     Average cycles between arrivals when no load factor is set (default 50)"<<endl;
+	cout<<"  --policy=POLICY *      sjf, aging, hrrn (approximate, 1% burst length buckets), edf, or sjf-feasible (default sjf)"<<endl;
+	cout<<"  --aging-rate=RATE *    Cycles of priority gained per cycle waited (default 0.25)"<<endl;
+	cout<<"  --pareto-shape, --pareto-min, --pareto-max, --mmpp-ratio, --mmpp-fraction, --mmpp-length, --diurnal-amplitude, --diurnal-period"<<endl;
+	cout<<"                         Workload model parameters (defaults 1.5, 1000, 1000000, 10, 0.1, 100, 0.8, 1000)"<<endl;
+	cout<<"  --deadline-fraction=F  Fraction of processes with a deadline (default 0, deadline mode 0.5)"<<endl;
+	cout<<"  --deadline-min, --deadline-max"<<endl;
+	cout<<"                         A deadline is the arrival time plus between min and max times the CPU cycles (defaults 2, 6)"<<endl;
+	cout<<"  --trace-file=FILE      Reads the processes for trace or deadline mode from a file (one \"arrival_time, CPU_cycles[, deadline]\" per line)"<<endl;
+	cout<<"  --nodes=N              Number of cluster nodes (default 1000)"<<endl;
+	cout<<"  --dispatch=POLICY      lwl, p2c, or jsq (default lwl)"<<endl;
+	cout<<"  --latency=CYCLES       Dispatch latency (default 100)"<<endl;
+	cout<<"  --output=FILE          Output file for batch mode (default - for the screen), cluster, timeline, energy, or deadline mode"<<endl;
+	cout<<"  --output-prefix=TEXT   Added to the front of the trace mode output file names"<<endl;
+	cout<<"  --threads=N            Threads for batch mode (default: number of hardware threads)"<<endl;
+	cout<<"  --timeline-format=F    json (Chrome trace-event JSON) or binary (columnar) (default json)"<<endl;
+	cout<<"  --timeline-resolution=CYCLES  Downsamples by merging back-to-back processes on a processor into intervals of up to CYCLES (default 0 = off)"<<endl;
+	cout<<"  --pstate-rates=R,..    CPU cycles per time unit of each P-state, fastest first (default 1,0.8,0.6,0.4)"<<endl;
+	cout<<"  --pstate-powers=P,..   Power of each P-state (default 1,0.56,0.29,0.16)"<<endl;
+	cout<<"  --idle-power, --sleep-power, --sleep-after, --wake-latency"<<endl;
+	cout<<"                         Idle processor power, sleep state power, idle time before sleeping, and wake-up time (defaults 0.3, 0.02, 1000, 100)"<<endl;
+	cout<<"  --short-cycles=CYCLES  Processes slack DVFS may slow down (default: the average CPU cycles of the burst model)"<<endl;
+	cout<<"  --deadline-stretch=X   Energy mode: a short process with no deadline must finish by its arrival time plus X times its CPU cycles (default 3)"<<endl;
+	cout<<"  --iterations=N         Number of fuzz mode cases (default 500, with up to --processes processes each, default 300)"<<endl;
+	cout<<"  --bench-processes=N,.. Process counts for the fuzz mode benchmarks (default 10000,100000,1000000)"<<endl;
+	cout<<"  --config=FILE          Reads options from a file (one name = value per line, # starts a comment)"<<endl;
+}
+
+//Returns the text without its leading and trailing spaces, tabs, and carriage returns
+string trim_whitespace(const string &text)
+{
+	size_t start = text.find_first_not_of(" \t\r");
+	
+	if(start == string::npos)
+	{
+		return "";
+	}
+	
+	return text.substr(start, text.find_last_not_of(" \t\r") - start + 1);
+}
+
+//Splits a comma-separated list of values (the spaces around each value are removed)
+vector<string> split_values(const string &text)
+{
+	vector<string> values;
+	size_t start = 0, comma = 0;
+	
+	while((comma = text.find(',', start)) != string::npos)
+	{
+		values.push_back(trim_whitespace(text.substr(start, comma - start)));
+		start = comma + 1;
+	}
+	
+	values.push_back(trim_whitespace(text.substr(start)));
+	
+	return values;
+}
+
+//Sets an option to a comma-separated list of values, returns false if there is no option with the name
+bool set_option(option_map &options, const string &name, const string &value)
+{
+	for(size_t index = 0; index < sizeof(option_names) / sizeof(option_names[0]); index++)
+	{
+		if(name == option_names[index])
+		{
+			options[name] = split_values(value);
+			return true;
+		}
+	}
+	
+	cout<<"Unknown option '"<<name<<"'."<<endl;
+	
+	return false;
+}
+
+//Reads options from a config file (one "name = value" per line, # starts a comment), returns false if the file cannot be read or has an unknown option
+bool read_config_file(const string &file_name, option_map &options)
+{
+	ifstream config_file(file_name.c_str());
+	
+	if(!config_file.is_open())
+	{
+		cout<<"Unable to open the config file '"<<file_name<<"'."<<endl;
+		return false;
+	}
+	
+	string line;
+	
+	while(getline(config_file, line))
+	{
+		line = trim_whitespace(line.substr(0, line.find('#'))); //Removes comments and the spaces around the line
+		
+		if(line.empty())
+		{
+			continue;
+		}
+		
+		size_t equals = line.find('=');
+		
+		//Only the spaces around the name and the value are removed (values such as file names can contain spaces)
+		if(equals == string::npos || !set_option(options, trim_whitespace(line.substr(0, equals)), line.substr(equals + 1)))
+		{
+			cout<<"Invalid line in the config file '"<<file_name<<"'."<<endl;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+//Reads processes from a trace file: one process per line as "arrival_time, CPU_cycles[, deadline]" (the deadline is an absolute time, and a missing deadline
+//or - means the process has none; # starts a comment). The processes are sorted by arrival time and numbered in that order
+//Returns false if the file cannot be read or a line is invalid
+bool read_trace_file(const string &file_name, vector<ready_job> &jobs)
+{
+	ifstream trace_file(file_name.c_str());
+	
+	if(!trace_file.is_open())
+	{
+		cout<<"Unable to open the trace file '"<<file_name<<"'."<<endl;
+		return false;
+	}
+	
+	jobs.clear();
+	
+	string line;
+	int line_number = 0;
+	
+	while(getline(trace_file, line))
+	{
+		line_number++;
+		line = line.substr(0, line.find('#')); //Removes comments
+		
+		replace(line.begin(), line.end(), ',', ' ');
+		
+		if(line.find_first_not_of(" \t\r") == string::npos)
+		{
+			continue;
+		}
+		
+		istringstream fields(line);
+		ready_job job = {0, 0, 0, NO_DEADLINE};
+		string deadline, extra;
+		
+		bool valid = (fields>>job.arrival_time>>job.CPU_cycles) && job.arrival_time >= 0 && job.CPU_cycles >= 1;
+		
+		//If there is a deadline: Reads it (it cannot come before the arrival time)
+		if(valid && (fields>>deadline) && deadline != "-")
+		{
+			char *end = nullptr;
+			job.deadline = strtoll(deadline.c_str(), &end, 10);
+			valid = (*end == '\0' && job.deadline >= job.arrival_time);
+		}
+		
+		if(!valid || (fields>>extra))
+		{
+			cout<<"Invalid line "<<line_number<<" in the trace file '"<<file_name<<"' (use: arrival_time, CPU_cycles[, deadline])."<<endl;
+			return false;
+		}
+		
+		jobs.push_back(job);
+	}
+	
+	stable_sort(jobs.begin(), jobs.end(), [](const ready_job &a, const ready_job &b) {
+		return a.arrival_time < b.arrival_time;
+	});
+	
+	for(size_t i = 0; i < jobs.size(); i++)
+	{
+		jobs[i].process_ID = i + 1;
+	}
+	
+	return true;
+}
+
+//Reads the mode (trace, batch, cluster, timeline, energy, deadline, or fuzz) and the options from the command line, returns false if an option is invalid
+//(if --help or -h is anywhere on the command line in place of an option name, only sets the help option)
+bool parse_options(int argc, char *argv[], option_map &options)
+{
+	for(int index = 1; index < argc; index++)
+	{
+		string argument = argv[index];
+		
+		if(argument == "--help" || argument == "-h")
+		{
+			options["help"] = vector<string>(1, "true");
+			return true;
+		}
+		
+		//If the option's value is the next argument: Skips it (so a value such as --output -h is not mistaken for --help)
+		if(argument.compare(0, 2, "--") == 0 && argument.find('=') == string::npos)
+		{
+			index++;
+		}
+	}
+	
+	for(int index = 1; index < argc; index++)
+	{
+		string argument = argv[index];
+		
+		//If the first argument is not an option: It is the mode
+		if(index == 1 && argument.compare(0, 2, "--") != 0)
+		{
+			options["mode"] = vector<string>(1, argument);
+			continue;
+		}
+		
+		if(argument.compare(0, 2, "--") != 0 || argument.size() == 2)
+		{
+			cout<<"Invalid argument '"<<argument<<"'."<<endl;
+			return false;
+		}
+		
+		string name = argument.substr(2), value;
+		size_t equals = name.find('=');
+		
+		//Reads the value from after the = sign, or from the next argument
+		if(equals != string::npos)
+		{
+			value = name.substr(equals + 1);
+			name = name.substr(0, equals);
+		}
+		else if(index + 1 < argc)
+		{
+			value = argv[++index];
+		}
+		else
+		{
+			cout<<"Missing value for option '"<<name<<"'."<<endl;
+			return false;
+		}
+		
+		if(name == "config")
+		{
+			if(!read_config_file(value, options))
+			{
+				return false;
+			}
+		}
+		else if(!set_option(options, name, value))
+		{
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+//Returns the values of an option (or the default value if the option was not set)
+vector<string> option_values(const option_map &options, const string &name, const string &default_value)
+{
+	option_map::const_iterator option = options.find(name);
+	
+	return (option == options.end()) ? split_values(default_value) : option->second;
+}
+
+//Reads the values of a numeric option, returns false if a value is not a number
+bool option_numbers(const option_map &options, const string &name, const string &default_value, vector<double> &numbers)
+{
+	vector<string> values = option_values(options, name, default_value);
+	
+	numbers.clear();
+	
+	for(size_t index = 0; index < values.size(); index++)
+	{
+		char *end = nullptr;
+		double number = strtod(values[index].c_str(), &end);
+		
+		if(values[index].empty() || *end != '\0')
+		{
+			cout<<"Invalid value '"<<values[index]<<"' for option '"<<name<<"'."<<endl;
+			return false;
+		}
+		
+		numbers.push_back(number);
+	}
+	
+	return true;
+}
+
+//Reads the single value of a numeric option, returns false if the value is not a number or there is more than one value
+bool option_number(const option_map &options, const string &name, const string &default_value, double &number)
+{
+	vector<double> numbers;
+	
+	if(!option_numbers(options, name, default_value, numbers))
+	{
+		return false;
+	}
+	
+	if(numbers.size() != 1)
+	{
+		cout<<"Option '"<<name<<"' takes a single value."<<endl;
+		return false;
+	}
+	
+	number = numbers[0];
+	
+	return true;
+}
+
+//Finds the burst model for a name (normal or pareto), returns false if the name is not a burst model
+bool parse_burst_model(const string &name, burst_model &bursts)
+{
+	if(name == "normal" || name == "pareto")
+	{
+		bursts = (name == "pareto") ? BURST_PARETO : BURST_NORMAL;
+		return true;
+	}
+	
+	return false;
+}
+
+//Finds the scheduling policy for a name (sjf, aging, hrrn, edf, or sjf-feasible), returns false if the name is not a scheduling policy
+bool parse_scheduling_policy(const string &name, scheduling_policy &policy)
+{
+	const scheduling_policy policies[5] = {POLICY_SJF, POLICY_AGING, POLICY_HRRN, POLICY_EDF, POLICY_SJF_FEASIBLE};
+	const string names[5] = {"sjf", "aging", "hrrn", "edf", "sjf-feasible"};
+	
+	for(int index = 0; index < 5; index++)
+	{
+		if(name == names[index])
+		{
+			policy = policies[index];
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+//Finds the dispatching policy for a name (lwl, p2c, or jsq), returns false if the name is not a dispatching policy
+bool parse_dispatch_policy(const string &name, dispatch_policy &policy)
+{
+	const dispatch_policy policies[3] = {DISPATCH_LEAST_WORK_LEFT, DISPATCH_POWER_OF_TWO, DISPATCH_JSQ};
+	const string names[3] = {"lwl", "p2c", "jsq"};
+	
+	for(int index = 0; index < 3; index++)
+	{
+		if(name == names[index])
+		{
+			policy = policies[index];
+			return true;
+		}
+	}
+	
+	return false;
+}
+
+//Checks that no option has more than one value (only batch mode runs parameter grids, and the P-state tables are lists)
+bool check_single_values(const option_map &options)
+{
+	for(option_map::const_iterator option = options.begin(); option != options.end(); option++)
+	{
+		if(option->second.size() != 1 && option->first != "pstate-rates" && option->first != "pstate-powers")
+		{
+			cout<<"Option '"<<option->first<<"' takes a single value outside of batch mode."<<endl;
+			return false;
+		}
+	}
+	
+	return true;
+}
+
+//Prints a warning to standard error for every option that a mode does not use (the option is ignored, so a typo in the mode or a misplaced option is easy to miss)
+void warn_unused_options(const option_map &options, const string &mode)
+{
+	const string arrival_options = " seed arrivals bursts load spacing pareto-shape pareto-min pareto-max mmpp-ratio mmpp-fraction mmpp-length diurnal-amplitude diurnal-period ";
+	const string workload_options = arrival_options + "deadline-fraction deadline-min deadline-max ";
+	
+	string used_options; //Options the mode reads, separated by spaces
+	
+	if(mode == "batch")
+	{
+		used_options = workload_options + "processes processors policy aging-rate output threads ";
+	}
+	else if(mode == "cluster")
+	{
+		used_options = arrival_options + "processes processors nodes dispatch latency output ";
+	}
+	else if(mode == "timeline")
+	{
+		used_options = workload_options + "processes processors policy aging-rate output timeline-format timeline-resolution ";
+	}
+	else if(mode == "energy")
+	{
+		used_options = workload_options + "processes processors policy aging-rate output pstate-rates pstate-powers idle-power sleep-power sleep-after wake-latency short-cycles deadline-stretch ";
+	}
+	else if(mode == "deadline")
+	{
+		used_options = workload_options + "processes processors aging-rate output trace-file ";
+	}
+	else if(mode == "fuzz")
+	{
+		used_options = " processes iterations seed bench-processes ";
+	}
+	else
+	{
+		used_options = workload_options + "processes processors aging-rate output-prefix trace-file ";
+	}
+	
+	for(option_map::const_iterator option = options.begin(); option != options.end(); option++)
+	{
+		if(option->first != "mode" && used_options.find(" " + option->first + " ") == string::npos)
+		{
+			cerr<<"Warning: option '"<<option->first<<"' is not used in "<<mode<<" mode and is ignored."<<endl;
+		}
+	}
+}
+
+//Reads the workload options (using the first value of the grid options), returns false if an option is invalid
+bool read_workload_options(const option_map &options, const string &default_load, workload_config &workload)
+{
+	default_workload(workload);
+	
+	double pareto_min = 0, pareto_max = 0;
+	
+	if(!option_number(options, "pareto-shape", "1.5", workload.pareto_shape) || !option_number(options, "pareto-min", "1000", pareto_min) ||
+	   !option_number(options, "pareto-max", "1000000", pareto_max) || !option_number(options, "mmpp-ratio", "10", workload.mmpp_rate_ratio) ||
+	   !option_number(options, "mmpp-fraction", "0.1", workload.mmpp_burst_fraction) || !option_number(options, "mmpp-length", "100", workload.mmpp_burst_length) ||
+	   !option_number(options, "diurnal-amplitude", "0.8", workload.diurnal_amplitude) || !option_number(options, "diurnal-period", "1000", workload.diurnal_period) ||
+	   !option_number(options, "deadline-fraction", "0", workload.deadline_fraction) || !option_number(options, "deadline-min", "2", workload.deadline_min_stretch) ||
+	   !option_number(options, "deadline-max", "6", workload.deadline_max_stretch))
+	{
+		return false;
+	}
+	
+	workload.pareto_min_cycles = pareto_min;
+	workload.pareto_max_cycles = pareto_max;
+	
+	vector<double> numbers;
+	
+	if(!option_numbers(options, "seed", to_string(workload.seed), numbers))
+	{
+		return false;
+	}
+	
+	//Checks every seed before it is converted to an unsigned int (the conversion is undefined for values outside its range)
+	for(size_t index = 0; index < numbers.size(); index++)
+	{
+		if(numbers[index] < 0 || numbers[index] > UINT_MAX)
+		{
+			cout<<"Invalid seed (use 0 - "<<UINT_MAX<<")."<<endl;
+			return false;
+		}
+	}
+	
+	workload.seed = numbers[0];
+	
+	//If a spacing is set without a load factor: The spacing is used instead of the mode's default load factor
+	if(!option_numbers(options, "load", (options.count("spacing") > 0) ? "0" : default_load, numbers))
+	{
+		return false;
+	}
+	
+	workload.load_factor = numbers[0];
+	
+	if(!option_numbers(options, "spacing", "50", numbers))
+	{
+		return false;
+	}
+	
+	workload.arrival_spacing = numbers[0];
+	
+	if(!parse_arrival_model(option_values(options, "arrivals", "fixed")[0], workload.arrivals) || !parse_burst_model(option_values(options, "bursts", "normal")[0], workload.bursts))
+	{
+		cout<<"Invalid arrival model (use fixed, poisson, mmpp, or diurnal) or burst model (use normal or pareto)."<<endl;
+		return false;
+	}
+	
+	if(workload.pareto_shape <= 1 || workload.pareto_min_cycles < 1 || workload.pareto_max_cycles <= workload.pareto_min_cycles || workload.mmpp_rate_ratio <= 0 ||
+	   workload.mmpp_burst_fraction <= 0 || workload.mmpp_burst_fraction >= 1 || workload.mmpp_burst_length <= 0 ||
+	   workload.diurnal_amplitude < 0 || workload.diurnal_amplitude > 1 || workload.diurnal_period <= 0 || workload.deadline_fraction < 0 || workload.deadline_fraction > 1 ||
+	   workload.deadline_min_stretch < 1 || workload.deadline_max_stretch < workload.deadline_min_stretch)
+	{
+		cout<<"Invalid workload model parameters."<<endl;
+		return false;
+	}
+	
+	return true;
+}
+
+//Runs task(index) for every index from 0 to count - 1 on a pool of threads
+void run_parallel(int count, int thread_count, const function<void(int)> &task)
+{
+	atomic<int> next_index(0);
+	vector<thread> threads;
+	
+	for(int index = 0; index < min(thread_count, count); index++)
+	{
+		threads.push_back(thread([&]() {
+			for(int task_index = next_index++; task_index < count; task_index = next_index++)
+			{
+				task(task_index);
+			}
+		}));
+	}
+	
+	for(size_t index = 0; index < threads.size(); index++)
+	{
+		threads[index].join();
+	}
+}
+
+//Workload shared by every batch configuration with the same process count, seed, arrival model, and burst model
+//Arrival times are generated for an average gap of 1 cycle and scaled for each configuration's load factor or spacing (every arrival model scales with the average gap)
+struct shared_workload
+{
+	workload_config workload;
+	int num_processes;
+	vector<int> cycles;
+	vector<double> unit_arrivals;
+	vector<long long> relative_deadlines; //Time each process has from its arrival to finish (NO_DEADLINE for processes with no deadline)
+};
+
+//One configuration (point in the parameter grid) of a batch run and its results
+struct batch_run
+{
+	int workload_index; //Index of the shared workload
+	double load_factor;
+	double arrival_spacing; //Requested spacing (replaced by the spacing actually used, which the load factor sets when there is one, once the run is scheduled)
+	int processor_count;
+	scheduling_policy policy;
+	double aging_rate;
+	
+	double avg_waiting_time;
+	long long p50_wait, p99_wait, p999_wait, max_wait, makespan;
+	double seconds;
+};
+
+//Generates the CPU cycles and unit arrival times of a shared workload
+void generate_shared_workload(shared_workload &shared)
+{
+	workload_config unit = shared.workload;
+	unit.load_factor = 0;
+	unit.arrival_spacing = 1;
+	
+	workload_generator generator;
+	init_workload_generator(generator, unit);
+	
+	shared.cycles.resize(shared.num_processes);
+	shared.unit_arrivals.resize(shared.num_processes);
+	shared.relative_deadlines.resize(shared.num_processes);
+	
+	//Generates the values in the same order as generate_processes, so a seed gives the same processes in every mode
+	for(int i = 0; i < shared.num_processes; i++)
+	{
+		shared.cycles[i] = generate_burst(generator);
+		generate_footprint(generator);
+		generate_arrival(generator);
+		shared.unit_arrivals[i] = generator.arrival_clock;
+		shared.relative_deadlines[i] = generate_deadline(generator, shared.cycles[i]);
+	}
+}
+
+//Builds the jobs of a shared workload (in arrival order), with the arrival times scaled to an average gap between arrivals
+void build_jobs(const shared_workload &shared, double spacing, vector<ready_job> &jobs)
+{
+	jobs.resize(shared.num_processes);
+	
+	for(int i = 0; i < shared.num_processes; i++)
+	{
+		ready_job job = {i + 1, shared.cycles[i], (long long)(shared.unit_arrivals[i] * spacing), NO_DEADLINE};
+		
+		if(shared.relative_deadlines[i] != NO_DEADLINE)
+		{
+			job.deadline = job.arrival_time + shared.relative_deadlines[i];
+		}
+		
+		jobs[i] = job;
+	}
+}
+
+//Schedules one batch configuration and calculates its waiting time statistics
+void run_batch_configuration(batch_run &run, const shared_workload &shared)
+{
+	chrono::steady_clock::time_point start_clock = chrono::steady_clock::now();
+	
+	workload_config workload = shared.workload;
+	workload.load_factor = run.load_factor;
+	workload.arrival_spacing = run.arrival_spacing;
+	workload.processor_count = run.processor_count;
+	
+	vector<ready_job> jobs;
+	vector<schedule_entry> schedule;
+	
+	run.arrival_spacing = mean_arrival_spacing(workload); //The spacing actually used (set by the load factor when there is one), which is what the CSV reports
+	
+	build_jobs(shared, run.arrival_spacing, jobs);
+	
+	schedule_jobs(jobs, run.processor_count, run.policy, run.aging_rate, false, schedule);
+	
+	vector<long long> waits(shared.num_processes);
+	
+	run.avg_waiting_time = 0;
+	run.makespan = 0;
+	
+	for(int i = 0; i < shared.num_processes; i++)
+	{
+		waits[i] = schedule[i].start_time - jobs[i].arrival_time;
+		run.avg_waiting_time += waits[i];
+		run.makespan = max(run.makespan, schedule[i].stop_time);
+	}
+	
+	run.avg_waiting_time /= shared.num_processes;
+	run.p50_wait = percentile(waits, 50);
+	run.p99_wait = percentile(waits, 99);
+	run.p999_wait = percentile(waits, 99.9);
+	run.max_wait = percentile(waits, 100);
+	
+	run.seconds = chrono::duration<double>(chrono::steady_clock::now() - start_clock).count();
+}
+
+//Runs every configuration in the parameter grid (in parallel) and writes one CSV line of waiting time statistics per configuration
+int run_batch(const option_map &options)
+{
+	workload_config base;
+	
+	vector<double> processes, processors, seeds, loads, spacings, aging_rates, threads;
+	vector<string> arrivals = option_values(options, "arrivals", "fixed"), bursts = option_values(options, "bursts", "normal"), policies = option_values(options, "policy", "sjf");
+	
+	if(!read_workload_options(options, "0", base) || !option_numbers(options, "processes", "50", processes) || !option_numbers(options, "processors", "4", processors) ||
+	   !option_numbers(options, "seed", to_string(base.seed), seeds) || !option_numbers(options, "load", "0", loads) || !option_numbers(options, "spacing", "50", spacings) ||
+	   !option_numbers(options, "aging-rate", "0.25", aging_rates) || !option_numbers(options, "threads", to_string(max(1u, thread::hardware_concurrency())), threads))
+	{
+		return 1;
+	}
+	
+	string output = option_values(options, "output", "-")[0];
+	
+	vector<shared_workload> workloads;
+	vector<batch_run> runs;
+	
+	//Expands the parameter grid: one shared workload per process count, seed, arrival model, and burst model, and one run per remaining combination
+	for(size_t p = 0; p < processes.size(); p++)
+	for(size_t s = 0; s < seeds.size(); s++)
+	for(size_t a = 0; a < arrivals.size(); a++)
+	for(size_t b = 0; b < bursts.size(); b++)
+	{
+		shared_workload shared;
+		shared.workload = base;
+		shared.workload.seed = seeds[s];
+		shared.num_processes = (processes[p] >= 1 && processes[p] <= INT_MAX) ? processes[p] : 0;
+		
+		if(!parse_arrival_model(arrivals[a], shared.workload.arrivals) || !parse_burst_model(bursts[b], shared.workload.bursts) || shared.num_processes < 1)
+		{
+			cout<<"Invalid process count, arrival model, or burst model."<<endl;
+			return 1;
+		}
+		
+		workloads.push_back(shared);
+		
+		for(size_t l = 0; l < loads.size(); l++)
+		for(size_t g = 0; g < spacings.size(); g++)
+		for(size_t c = 0; c < processors.size(); c++)
+		for(size_t y = 0; y < policies.size(); y++)
+		for(size_t r = 0; r < aging_rates.size(); r++)
+		{
+			//The spacing is only used when there is no load factor, so only the first spacing is run with a load factor
+			if(loads[l] > 0 && g > 0)
+			{
+				continue;
+			}
+			
+			batch_run run;
+			run.workload_index = workloads.size() - 1;
+			run.load_factor = loads[l];
+			run.arrival_spacing = spacings[g];
+			run.processor_count = processors[c];
+			run.aging_rate = aging_rates[r];
+			
+			if(!parse_scheduling_policy(policies[y], run.policy) || run.processor_count < 1 || run.load_factor < 0 || (run.load_factor == 0 && run.arrival_spacing < 0))
+			{
+				cout<<"Invalid processor count, load factor, spacing, or scheduling policy."<<endl;
+				return 1;
+			}
+			
+			runs.push_back(run);
+		}
+	}
+	
+	ofstream output_file;
+	
+	if(output != "-")
+	{
+		output_file.open(output.c_str());
+		
+		if(!output_file.is_open())
+		{
+			cout<<"Unable to open the batch output file '"<<output<<"'."<<endl;
+			return 1;
+		}
+	}
+	
+	ostream &out = (output == "-") ? cout : (ostream&)output_file;
+	int thread_count = max(1, (int)threads[0]);
+	
+	//Generates each shared workload once, then runs every configuration (both in parallel)
+	run_parallel(workloads.size(), thread_count, [&](int index) { generate_shared_workload(workloads[index]); });
+	run_parallel(runs.size(), thread_count, [&](int index) { run_batch_configuration(runs[index], workloads[runs[index].workload_index]); });
+	
+	//Prints the results in grid order
+	out<<"processes,processors,seed,arrivals,bursts,load,spacing,policy,aging_rate,average_wait,p50_wait,p99_wait,p99.9_wait,max_wait,makespan,seconds"<<endl;
+	
+	for(size_t index = 0; index < runs.size(); index++)
+	{
+		const batch_run &run = runs[index];
+		const shared_workload &shared = workloads[run.workload_index];
+		
+		out<<shared.num_processes<<","<<run.processor_count<<","<<shared.workload.seed<<","<<arrival_model_name(shared.workload.arrivals)<<","
+		   <<(shared.workload.bursts == BURST_PARETO ? "Pareto" : "Normal")<<","<<run.load_factor<<","<<run.arrival_spacing<<","<<scheduling_policy_name(run.policy)<<","
+		   <<run.aging_rate<<","<<fixed<<setprecision(2)<<run.avg_waiting_time<<","<<run.p50_wait<<","<<run.p99_wait<<","<<run.p999_wait<<","
+		   <<run.max_wait<<","<<run.makespan<<","<<setprecision(4)<<run.seconds<<endl;
+		
+		out.unsetf(ios::floatfield);
+		out<<setprecision(6);
+	}
+	
+	return 0;
+}
+
+//Runs a cluster simulation using the options, returns the program's exit code
+int run_cluster(const option_map &options)
+{
+	cluster_config config;
+	
+	double nodes = 0, processors = 0, jobs = 0, latency = 0;
+	
+	if(!read_workload_options(options, "0.9", config.workload) || !option_number(options, "nodes", "1000", nodes) || !option_number(options, "processors", "4", processors) ||
+	   !option_number(options, "processes", "10000000", jobs) || !option_number(options, "latency", "100", latency))
+	{
+		return 1;
+	}
+	
+	config.node_count = nodes;
+	config.processor_count = processors;
+	config.num_jobs = jobs;
+	config.dispatch_latency = latency;
+	config.output_file = option_values(options, "output", "SJF Output (cluster).txt")[0];
+	
+	if(!parse_dispatch_policy(option_values(options, "dispatch", "lwl")[0], config.policy))
+	{
+		cout<<"Unknown dispatching policy (use lwl, p2c, or jsq)."<<endl;
+		return 1;
+	}
+	
+	if(config.node_count < 1 || config.processor_count < 1 || config.num_jobs < 1 || config.num_jobs > INT_MAX || config.dispatch_latency < 0 ||
+	   config.workload.load_factor < 0 || config.workload.arrival_spacing < 0)
+	{
+		cout<<"Invalid cluster settings."<<endl;
+		return 1;
+	}
+	
+	SJF_cluster(config);
+	
+	return 0;
+}
+
+//Schedules the processes with one policy and exports the timeline (one interval per processor, process, start, and stop), returns the program's exit code
+int run_timeline(const option_map &options)
+{
+	workload_config workload;
+	scheduling_policy policy;
+	timeline_format format;
+	
+	double processes = 0, processors = 0, aging_rate = 0, resolution = 0;
+	
+	if(!read_workload_options(options, "0", workload) || !option_number(options, "processes", "1000000", processes) || !option_number(options, "processors", "4", processors) ||
+	   !option_number(options, "aging-rate", "0.25", aging_rate) || !option_number(options, "timeline-resolution", "0", resolution))
+	{
+		return 1;
+	}
+	
+	string format_name = option_values(options, "timeline-format", "json")[0];
+	
+	if(!parse_scheduling_policy(option_values(options, "policy", "sjf")[0], policy) || (format_name != "json" && format_name != "binary"))
+	{
+		cout<<"Invalid scheduling policy (use sjf, aging, hrrn, edf, or sjf-feasible) or timeline format (use json or binary)."<<endl;
+		return 1;
+	}
+	
+	format = (format_name == "json") ? TIMELINE_JSON : TIMELINE_BINARY;
+	
+	if(processes < 1 || processes > INT_MAX || processors < 1 || resolution < 0 || workload.load_factor < 0 || workload.arrival_spacing < 0)
+	{
+		cout<<"Invalid number of processes, number of processors, timeline resolution, load factor, or spacing."<<endl;
+		return 1;
+	}
+	
+	string file_name = option_values(options, "output", (format == TIMELINE_JSON) ? "SJF Timeline.json" : "SJF Timeline.bin")[0];
+	
+	chrono::steady_clock::time_point start_clock = chrono::steady_clock::now();
+	
+	//Generates the processes the same way as batch mode, so a seed gives the same schedule in both modes
+	shared_workload shared;
+	shared.workload = workload;
+	shared.num_processes = processes;
+	shared.workload.processor_count = processors;
+	
+	generate_shared_workload(shared);
+	
+	vector<ready_job> jobs;
+	vector<schedule_entry> schedule;
+	
+	build_jobs(shared, mean_arrival_spacing(shared.workload), jobs);
+	schedule_jobs(jobs, processors, policy, aging_rate, false, schedule);
+	
+	long long interval_count = 0, bytes_written = 0;
+	
+	if(!export_timeline(file_name, format, jobs, schedule, processors, resolution, interval_count, bytes_written))
+	{
+		cout<<"Unable to write the timeline file '"<<file_name<<"'."<<endl;
+		return 1;
+	}
+	
+	double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_clock).count();
+	
+	cout<<"Timeline ("<<scheduling_policy_name(policy)<<", "<<(long long)processes<<" processes on "<<(int)processors<<" processors): "<<interval_count<<" intervals, "
+		<<bytes_written<<" bytes written to '"<<file_name<<"' in "<<fixed<<setprecision(2)<<elapsed_seconds<<" seconds"<<endl;
+	
+	return 0;
+}
+
+//Runs an energy simulation using the options (comparing race to idle against slack DVFS on the same processes), returns the program's exit code
+int run_energy(const option_map &options)
+{
+	workload_config workload;
+	energy_config config;
+	processor_power power;
+	
+	double processes = 0, processors = 0, sleep_after = 0, wake_latency = 0, short_cycles = 0;
+	vector<double> rates, powers;
+	
+	if(!read_workload_options(options, "0.6", workload) || !option_number(options, "processes", "100000", processes) || !option_number(options, "processors", "4", processors) ||
+	   !option_number(options, "aging-rate", "0.25", config.aging_rate) || !option_numbers(options, "pstate-rates", "1,0.8,0.6,0.4", rates) ||
+	   !option_numbers(options, "pstate-powers", "1,0.56,0.29,0.16", powers) || !option_number(options, "idle-power", "0.3", power.idle_power) ||
+	   !option_number(options, "sleep-power", "0.02", power.sleep_power) || !option_number(options, "sleep-after", "1000", sleep_after) ||
+	   !option_number(options, "wake-latency", "100", wake_latency) || !option_number(options, "short-cycles", to_string((long long)mean_burst_cycles(workload)), short_cycles) ||
+	   !option_number(options, "deadline-stretch", "3", config.deadline_stretch))
+	{
+		return 1;
+	}
+	
+	if(!parse_scheduling_policy(option_values(options, "policy", "sjf")[0], config.policy))
+	{
+		cout<<"Unknown scheduling policy (use sjf, aging, hrrn, edf, or sjf-feasible)."<<endl;
+		return 1;
+	}
+	
+	if(rates.size() != powers.size())
+	{
+		cout<<"--pstate-rates and --pstate-powers need one value for each P-state."<<endl;
+		return 1;
+	}
+	
+	//Builds the P-state table (P0 must be the fastest P-state)
+	for(size_t index = 0; index < rates.size(); index++)
+	{
+		p_state state = {rates[index], powers[index]};
+		
+		if(state.cycle_rate <= 0 || state.cycle_rate > rates[0] || state.power < 0)
+		{
+			cout<<"Invalid P-state "<<index<<" (cycle rates must be greater than 0 and no faster than P0, and power cannot be negative)."<<endl;
+			return 1;
+		}
+		
+		power.p_states.push_back(state);
+	}
+	
+	if(processes < 1 || processes > INT_MAX || processors < 1 || workload.load_factor < 0 || workload.arrival_spacing < 0 || power.idle_power < 0 || power.sleep_power < 0 ||
+	   sleep_after < 0 || wake_latency < 0 || config.deadline_stretch < 1)
+	{
+		cout<<"Invalid energy settings."<<endl;
+		return 1;
+	}
+	
+	power.sleep_after = sleep_after;
+	power.wake_latency = wake_latency;
+	
+	config.processor_count = processors;
+	config.processors.assign(config.processor_count, power); //Each processor has its own copy of the power model and its own P-state
+	config.short_cycles = short_cycles;
+	config.output_file = option_values(options, "output", "SJF Output (energy).txt")[0];
+	
+	//Generates the processes the same way as batch mode, so a seed gives the same processes in both modes
+	shared_workload shared;
+	shared.workload = workload;
+	shared.num_processes = processes;
+	shared.workload.processor_count = processors;
+	
+	generate_shared_workload(shared);
+	
+	vector<ready_job> jobs;
+	build_jobs(shared, mean_arrival_spacing(shared.workload), jobs);
+	
+	SJF_energy(jobs, config);
+	
+	return 0;
+}
+
+//Runs the deadline comparison (every scheduling policy with and without admission control) using the options, returns the program's exit code
+int run_deadline(const option_map &options)
+{
+	workload_config workload;
+	
+	double processes = 0, processors = 0, aging_rate = 0;
+	
+	//Half of the processes have deadlines unless --deadline-fraction says otherwise
+	if(!read_workload_options(options, "0.9", workload) || !option_number(options, "deadline-fraction", "0.5", workload.deadline_fraction) ||
+	   !option_number(options, "processes", "1000000", processes) || !option_number(options, "processors", "4", processors) || !option_number(options, "aging-rate", "0.25", aging_rate))
+	{
+		return 1;
+	}
+	
+	if(processes < 1 || processes > INT_MAX || processors < 1 || workload.load_factor < 0 || workload.arrival_spacing < 0 || workload.deadline_fraction < 0 || workload.deadline_fraction > 1)
+	{
+		cout<<"Invalid number of processes, number of processors, load factor, spacing, or deadline fraction."<<endl;
+		return 1;
+	}
+	
+	vector<ready_job> jobs;
+	string trace_file = option_values(options, "trace-file", "")[0];
+	
+	//Reads the processes from the trace file if there is one, otherwise generates them the same way as batch mode
+	if(!trace_file.empty())
+	{
+		if(!read_trace_file(trace_file, jobs))
+		{
+			return 1;
+		}
+		
+		if(jobs.empty())
+		{
+			cout<<"The trace file '"<<trace_file<<"' has no processes."<<endl;
+			return 1;
+		}
+	}
+	else
+	{
+		shared_workload shared;
+		shared.workload = workload;
+		shared.num_processes = processes;
+		shared.workload.processor_count = processors;
+		
+		generate_shared_workload(shared);
+		
+		build_jobs(shared, mean_arrival_spacing(shared.workload), jobs);
+	}
+	
+	SJF_deadline(jobs, processors, aging_rate, option_values(options, "output", "SJF Output (deadline).txt")[0]);
+	
+	return 0;
+}
+
+//Compares a schedule against the reference schedule of the same jobs, returns the index in jobs of the first process whose start time,
+//stop time, or waiting time differs (or -1 if they all match)
+//waiting_times holds the waiting time reported by the engine (indexed by process ID - 1) and wait_offset is added to the reference waiting time
+int compare_schedules(const vector<ready_job> &jobs, const vector<schedule_entry> &reference, const vector<schedule_entry> &schedule, const vector<long long> &waiting_times, long long wait_offset)
+{
+	for(size_t i = 0; i < jobs.size(); i++)
+	{
+		int index = jobs[i].process_ID - 1;
+		long long reference_wait = reference[index].start_time - jobs[i].arrival_time;
+		
+		if(schedule[index].start_time != reference[index].start_time || schedule[index].stop_time != reference[index].stop_time || waiting_times[index] != reference_wait + wait_offset)
+		{
+			return i;
+		}
+	}
+	
+	return -1;
+}
+
+//Returns the waiting time of every process in a schedule (indexed by process ID - 1)
+vector<long long> schedule_waiting_times(const vector<ready_job> &jobs, const vector<schedule_entry> &schedule)
+{
+	vector<long long> waits(jobs.size());
+	
+	for(size_t i = 0; i < jobs.size(); i++)
+	{
+		waits[jobs[i].process_ID - 1] = schedule[jobs[i].process_ID - 1].start_time - jobs[i].arrival_time;
+	}
+	
+	return waits;
+}
+
+//Runs the jobs through the cluster engine with a single node and the given dispatch latency, and stores the resulting schedule
+//(jobs reach the node dispatch_latency cycles after they arrive, so the matching reference schedule uses arrival times dispatch_latency cycles later)
+void cluster_node_schedule(const vector<ready_job> &jobs, int processor_count, long long dispatch_latency, vector<schedule_entry> &schedule, vector<long long> &waiting_times)
+{
+	cluster_config config;
+	config.node_count = 1;
+	config.processor_count = processor_count;
+	config.num_jobs = jobs.size();
+	config.policy = DISPATCH_LEAST_WORK_LEFT;
+	config.dispatch_latency = dispatch_latency;
+	default_workload(config.workload);
+	config.workload.seed = 0;
+	
+	vector<cluster_node> nodes;
+	
+	simulate_cluster(config, [&](long long job_index) { return jobs[job_index]; }, nodes, waiting_times);
+	
+	schedule.resize(jobs.size());
+	
+	for(size_t i = 0; i < jobs.size(); i++)
+	{
+		schedule_entry &entry = schedule[jobs[i].process_ID - 1];
+		entry.start_time = jobs[i].arrival_time + waiting_times[jobs[i].process_ID - 1];
+		entry.stop_time = entry.start_time + jobs[i].CPU_cycles;
+		entry.processor = 0;
+		entry.rejected = false;
+	}
+}
+
+//Runs the seeded randomized differential fuzzer: every case schedules a random workload with a random policy and processor count on the reference scheduler
+//and on each faster engine, and compares the start, stop, and waiting time of every process. Then benchmarks the engines' throughput
+//Returns the program's exit code (1 if any schedule differs from the reference)
+int run_fuzz(const option_map &options)
+{
+	double iterations = 0, max_processes = 0, seed = 0;
+	vector<double> bench_sizes;
+	
+	if(!option_number(options, "iterations", "500", iterations) || !option_number(options, "processes", "300", max_processes) ||
+	   !option_number(options, "seed", to_string(random_device()()), seed) || !option_numbers(options, "bench-processes", "10000,100000,1000000", bench_sizes))
+	{
+		return 1;
+	}
+	
+	if(iterations < 0 || max_processes < 1 || max_processes > INT_MAX || seed < 0 || seed > UINT_MAX)
+	{
+		cout<<"Invalid number of iterations, processes, or seed."<<endl;
+		return 1;
+	}
+	
+	for(size_t size = 0; size < bench_sizes.size(); size++)
+	{
+		if(bench_sizes[size] > INT_MAX)
+		{
+			cout<<"Invalid number of benchmark processes."<<endl;
+			return 1;
+		}
+	}
+	
+	cout<<"Differential fuzzer: "<<(long long)iterations<<" cases of up to "<<(long long)max_processes<<" processes, seed "<<(unsigned int)seed<<endl;
+	
+	long long cases_checked[2] = {0, 0}, failures = 0; //Cases checked for the policy scheduler and the cluster node engine
+	
+	for(long long iteration = 0; iteration < iterations; iteration++)
+	{
+		mt19937 case_generator((unsigned int)seed + iteration); //Each case has its own seed, so a failing case can be rerun on its own
+		
+		int num_processes = 1 + case_generator() % (int)max_processes;
+		int processor_count = 1 + case_generator() % 8;
+		scheduling_policy policy = (scheduling_policy)(case_generator() % 5);
+		double aging_rate = ldexp(1.0, (int)(case_generator() % 8) - 6); //1/64 - 2: powers of 2 keep both aging formulas exact, so ties match
+		int burst_shape = case_generator() % 4; //0 = normal, 1 = Pareto, 2 = a few burst lengths at least 5% apart (many ties), 3 = every burst the same
+		
+		shared_workload shared;
+		default_workload(shared.workload);
+		shared.workload.seed = case_generator();
+		shared.workload.arrivals = (arrival_model)(case_generator() % 4);
+		shared.workload.bursts = (burst_shape == 1) ? BURST_PARETO : BURST_NORMAL;
+		shared.workload.load_factor = 0.2 + (case_generator() % 140) / 100.0; //Light load through overload
+		shared.workload.processor_count = processor_count;
+		shared.workload.deadline_fraction = (case_generator() % 3) / 2.0; //No deadlines, half of the processes, or every process
+		shared.workload.deadline_min_stretch = 1;
+		shared.workload.deadline_max_stretch = 1 + case_generator() % 8;
+		shared.num_processes = num_processes;
+		
+		//Sometimes every process arrives at time 0
+		if(case_generator() % 8 == 0)
+		{
+			shared.workload.load_factor = 0;
+			shared.workload.arrival_spacing = 0;
+		}
+		
+		generate_shared_workload(shared);
+		
+		vector<ready_job> jobs;
+		build_jobs(shared, mean_arrival_spacing(shared.workload), jobs);
+		
+		int same_cycles = 1000 + case_generator() % 5000;
+		
+		for(int i = 0; i < num_processes; i++)
+		{
+			if(burst_shape == 2)
+			{
+				jobs[i].CPU_cycles = 1000 * pow(1.05, (int)(case_generator() % 40));
+			}
+			else if(burst_shape == 3)
+			{
+				jobs[i].CPU_cycles = same_cycles;
+			}
+		}
+		
+		long long dispatch_latency = case_generator() % 4; //The cluster node engine's dispatch latency (0 - 3 cycles)
+		
+		vector<schedule_entry> reference, schedule;
+		vector<long long> waiting_times;
+		
+		string engine_names[2] = {"policy scheduler", "cluster node engine"};
+		
+		for(int engine = 0; engine < 2; engine++)
+		{
+			vector<ready_job> reference_jobs = jobs;
+			long long wait_offset = 0;
+			
+			//The policy scheduler handles every policy, the cluster node engine only handles SJF
+			if(engine == 0)
+			{
+				schedule_jobs(jobs, processor_count, policy, aging_rate, false, schedule);
+				waiting_times = schedule_waiting_times(jobs, schedule);
+			}
+			else if(policy == POLICY_SJF)
+			{
+				cluster_node_schedule(jobs, processor_count, dispatch_latency, schedule, waiting_times);
 				
-					sjf_file<<endl;
-					
-					//Initialize min_cycles_index in order to avoid assigning it to an empty (0 value) element in the array of remaining processor cycles
-					for(int index=0; index < processor_count; index++)
-					{
-						//If the current element in the array of remaining processor cycles is non-zero: Set the min_cycles_index to the current index location in the array and exit the loop
-						//Else: Increment the min_cycles_index location
-						if(processor_cycles[index] > 0)
-						{
-							min_cycles_index = index;
-							break;
-						}
-						else
-						{
-							min_cycles_index++;
-						}
-					}
-					
-					//Loop until the smallest remaining cycles left to execute for the currently executing processes is found
-					for(int index=0; index < processor_count; index++)
-					{
-						//If the current element in the remaining processes cycle is non-zero and the current element is smaller than the previously set min_cycles_index: Set the new index location for the min_cycles_index
-						if(processor_cycles[index] > 0 && processor_cycles[index] <= processor_cycles[min_cycles_index])
-						{
-							min_cycles_index = index;
-						}
-					}
-					
-					processes_executed++; //Increment the number of processes that have completed execution
-					
-					current_time += processor_cycles[min_cycles_index]; //Increment the current time based upon the process with the smallest cycles left to execute (this is the next time the processor would swap processes)
-				}
-				else //Currently empty processor(s)
+				//Jobs reach the node after the dispatch latency, and the cluster measures waiting time from the dispatcher
+				for(int i = 0; i < num_processes; i++)
 				{
-					//Schedule the first process to execute in processor 1, based on which process has the smallest cycles remaining
-					switch(min_cycles_index)
-					{
-						case 0: //For Processor 1
-						{
-							processor1_schedule.push_back(process_queue[i]); //Add the new process to the processor schedule
-					
-							process_queue.erase(process_queue.begin()+i); //Delete the new process from the process queue
-							
-							processor1_schedule[0]->start_time = current_time; //Set the start time for the new process
-							processor1_schedule[0]->stop_time = processor1_schedule[0]->CPU_cycles; //Calculate and set the stop time for the new process
-							
-							processor1_schedule[0]->waiting_time = current_time - processor1_schedule[0]->arrival_time; //Calculate and set the waiting time for the new process
-							total_waiting_time += processor1_schedule[processor1_index]->waiting_time; //Increment the new waiting time into the total waiting time overall
-							
-							processor_cycles[0] = processor1_schedule[0]->CPU_cycles; //Initialize processor cycles
-							
-							break;
-						}
-						case 1: //For Processor 2
-						{
-							processor2_schedule.push_back(process_queue[i]); //Add the new process to the processor schedule
-						
-							process_queue.erase(process_queue.begin()+i); //Delete the new process from the process queue
-							
-							processor2_schedule[0]->start_time = current_time; //Set the start time for the new process
-							processor2_schedule[0]->stop_time = current_time + processor2_schedule[0]->CPU_cycles; //Calculate and set the stop time for the new process
-							
-							processor2_schedule[0]->waiting_time = current_time - processor2_schedule[0]->arrival_time; //Calculate and set the waiting time for the new process
-							total_waiting_time += processor2_schedule[processor2_index]->waiting_time; //Increment the new waiting time into the total waiting time overall
-							
-							processor_cycles[1] = processor2_schedule[0]->CPU_cycles; //Initialize processor cycles
-							
-							break;
-						}
-						case 2: //For Processor 3
-						{
-							processor3_schedule.push_back(process_queue[i]); //Add the new process to the processor schedule
-						
-							process_queue.erase(process_queue.begin()+i); //Delete the new process from the process queue
-							
-							processor3_schedule[0]->start_time = current_time; //Set the start time for the new process
-							processor3_schedule[0]->stop_time = current_time + processor3_schedule[0]->CPU_cycles; //Calculate and set the stop time for the new process
-							
-							processor3_schedule[0]->waiting_time = current_time - processor3_schedule[0]->arrival_time; //Calculate and set the waiting time for the new process
-							total_waiting_time += processor3_schedule[processor3_index]->waiting_time; //Increment the new waiting time into the total waiting time overall
-					
-							processor_cycles[2] = processor3_schedule[0]->CPU_cycles; //Initialize processor cycles
-							
-							break;
-						}
-						case 3: //For Processor 4
-						{
-							processor4_schedule.push_back(process_queue[i]); //Add the new process to the processor schedule
-						
-							process_queue.erase(process_queue.begin()+i); //Delete the new process from the process queue
-							
-							processor4_schedule[0]->start_time = current_time; //Set the start time for the new process
-							processor4_schedule[0]->stop_time = current_time + processor4_schedule[0]->CPU_cycles; //Calculate and set the stop time for the new process
-							
-							processor4_schedule[0]->waiting_time = current_time - processor4_schedule[0]->arrival_time; //Calculate and set the waiting time for the new process
-							total_waiting_time += processor4_schedule[processor4_index]->waiting_time; //Increment the new waiting time into the total waiting time overall
-						
-							processor_cycles[3] = processor4_schedule[0]->CPU_cycles; //Initialize processor cycles
-							
-							processes_executed++; //Increment the number of processes that have completed execution
-							
-							break;
-						}
-					}
-					
-					//Loop through the processors and print out the current process execution information for each
-					for(int index = 0; index < processor_count; index++)
-					{
-						if(index > min_cycles_index) //Print out currently empty processors
-						{
-							//Prints the currently generated process' information
-							sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-								  <<setw(10)<<"-"<<"\t"
-								  <<setw(6)<<right<<"-"<<"\t"
-								  <<setw(16)<<"-"<<"\t"
-								  <<setw(12)<<"-"<<"\t"
-								  <<setw(10)<<"-"<<"\t"
-								  <<setw(9)<<"-"<<"\t"
-								  <<setw(12)<<"-"<<"\t"
-								  <<setw(16)<<"-"<<endl;
-						}
-						else //Print out currently running processors
-						{
-							//Print out the current processor's (based on index) current process execution information based on the current processor
-							switch(index)
-							{
-								case 0: //For Processor 1
-								{
-									//If the current time is not 0: Decrement remaining cycles for the process in Processor 1
-									if(current_time > 0)
-									{
-										processor1_schedule[0]->remaining_cycles -= 50;
-										processor_cycles[0] -= 50;
-									}
-									
-									//Prints the currently executing process' information
-									sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-										  <<setw(10)<<"p" + to_string( processor1_schedule[0]->process_ID )<<"\t"
-										  <<setw(6)<<right<<processor1_schedule[0]->CPU_cycles<<"\t"
-										  <<setw(16)<<processor1_schedule[0]->memory_footprint<<"\t"
-										  <<setw(12)<<processor1_schedule[0]->arrival_time<<"\t"
-										  <<setw(10)<<processor1_schedule[0]->start_time<<"\t" //Prints out the start time
-										  <<setw(9)<<processor1_schedule[0]->stop_time<<"\t" //Prints out the stop time
-										  <<setw(12)<<processor1_schedule[0]->waiting_time<<"\t" //Prints waiting time
-										  <<setw(16)<<processor1_schedule[0]->remaining_cycles<<endl; //Prints remaining cycles
-									break;
-								}
-								case 1: //For Processor 2
-								{
-									//If the current time is not 50: Decrement remaining cycles for the process in Processor 1
-									if(current_time > 50)
-									{
-										processor2_schedule[0]->remaining_cycles -= 50;
-										processor_cycles[1] -= 50;
-									}
-										
-									//Prints the currently executing process' information
-									sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-										  <<setw(10)<<"p" + to_string( processor2_schedule[0]->process_ID )<<"\t"
-										  <<setw(6)<<right<<processor2_schedule[0]->CPU_cycles<<"\t"
-										  <<setw(16)<<processor2_schedule[0]->memory_footprint<<"\t"
-										  <<setw(12)<<processor2_schedule[0]->arrival_time<<"\t"
-										  <<setw(10)<<processor2_schedule[0]->start_time<<"\t" //Prints out the start time
-										  <<setw(9)<<processor2_schedule[0]->stop_time<<"\t" //Prints out the stop time
-										  <<setw(12)<<processor2_schedule[0]->waiting_time<<"\t" //Prints waiting time
-										  <<setw(16)<<processor2_schedule[0]->remaining_cycles<<endl; //Prints remaining cycles
-									
-									break;
-								}
-								case 2: //For Processor 3
-								{
-									//If the current time is not 100: Decrement remaining cycles for the process in Processor 1
-									if(current_time > 100)
-									{
-										processor3_schedule[0]->remaining_cycles -= 50;
-										processor_cycles[2] -= 50;
-									}
-									
-									//Prints the currently executing process' information
-									sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-										  <<setw(10)<<"p" + to_string( processor3_schedule[0]->process_ID )<<"\t"
-										  <<setw(6)<<right<<processor3_schedule[0]->CPU_cycles<<"\t"
-										  <<setw(16)<<processor3_schedule[0]->memory_footprint<<"\t"
-										  <<setw(12)<<processor3_schedule[0]->arrival_time<<"\t"
-										  <<setw(10)<<processor3_schedule[0]->start_time<<"\t" //Prints out the start time
-										  <<setw(9)<<processor3_schedule[0]->stop_time<<"\t" //Prints out the stop time
-										  <<setw(12)<<processor3_schedule[0]->waiting_time<<"\t" //Prints waiting time
-										  <<setw(16)<<processor3_schedule[0]->remaining_cycles<<endl; //Prints remaining cycles
-									
-									break;
-								}
-								case 3: //For Processor 4
-								{
-									//Prints the currently executing process' information
-									sjf_file<<setw(12)<<left<<"Processor " + to_string(index+1) + ":"<<"\t"
-										  <<setw(10)<<"p" + to_string( processor4_schedule[0]->process_ID )<<"\t"
-										  <<setw(6)<<right<<processor4_schedule[0]->CPU_cycles<<"\t"
-										  <<setw(16)<<processor4_schedule[0]->memory_footprint<<"\t"
-										  <<setw(12)<<processor4_schedule[0]->arrival_time<<"\t"
-										  <<setw(10)<<processor4_schedule[0]->start_time<<"\t" //Prints out the start time
-										  <<setw(9)<<processor4_schedule[0]->stop_time<<"\t" //Prints out the stop time
-										  <<setw(12)<<processor4_schedule[0]->waiting_time<<"\t" //Prints waiting time
-										  <<setw(16)<<processor4_schedule[0]->remaining_cycles<<endl; //Prints remaining cycles
-									
-									break;
-								}
-							}
-						}
-					}
-					
-					sjf_file<<endl;
-					
-					//If not all processors are executing processes: Increment to the next processor and new time
-					//Else: Determine the process with the current smallest remaining cycles so it can be swapped with a new process
-					if(min_cycles_index < processor_count-1)
-					{
-						min_cycles_index++;
-					
-						current_time += 50;	
-					}
-					else
-					{
-						min_cycles_index = 0;
-						
-						//Loop to determine the index with the smallest remaining cycles to execute
-						for(int index=0; index < processor_count; index++)
-						{
-							if(processor_cycles[index] < processor_cycles[min_cycles_index])
-							{
-								min_cycles_index = index;
-							}
-						}
-						
-						current_time += processor_cycles[min_cycles_index]; //Increment to the next current time (when a new process will be swapped for a currently executing process)
-					}
+					reference_jobs[i].arrival_time += dispatch_latency;
 				}
 				
-				i = 0; //Reset the process queue index back to the beginning before determining the next process to execute
+				wait_offset = dispatch_latency;
 			}
 			else
 			{
-				i++; //Increment the process queue index back to look at the next possible process to execut
+				continue;
+			}
+			
+			reference_schedule(reference_jobs, processor_count, policy, aging_rate, reference);
+			
+			cases_checked[engine]++;
+			
+			int mismatch = compare_schedules(reference_jobs, reference, schedule, waiting_times, wait_offset);
+			
+			//If the schedules differ: Print the case and the first process that differs
+			if(mismatch >= 0)
+			{
+				const ready_job &job = reference_jobs[mismatch];
+				const schedule_entry &expected = reference[job.process_ID - 1], &actual = schedule[job.process_ID - 1];
+				
+				failures++;
+				
+				cout<<"MISMATCH ("<<engine_names[engine]<<") in case "<<iteration<<" (rerun with --seed "<<(unsigned int)(seed + iteration)<<" --iterations 1): "
+					<<scheduling_policy_name(policy)<<", "<<num_processes<<" processes, "<<processor_count<<" processors, "<<arrival_model_name(shared.workload.arrivals)
+					<<" arrivals, burst shape "<<burst_shape<<endl;
+				cout<<"  p"<<job.process_ID<<" (cycles "<<job.CPU_cycles<<", arrival "<<job.arrival_time<<", deadline "<<((job.deadline == NO_DEADLINE) ? "-" : to_string(job.deadline))<<"): reference start/stop/wait = "
+					<<expected.start_time<<"/"<<expected.stop_time<<"/"<<expected.start_time - job.arrival_time + wait_offset
+					<<", engine = "<<actual.start_time<<"/"<<actual.stop_time<<"/"<<waiting_times[job.process_ID - 1]<<endl;
 			}
 		}
+	}
+	
+	cout<<"Policy scheduler: "<<cases_checked[0]<<" cases checked, cluster node engine: "<<cases_checked[1]<<" cases checked, "<<failures<<" mismatches"<<endl<<endl;
+	
+	//Benchmarks each engine on Poisson arrivals at a 0.95 load factor on 4 processors (the reference scheduler only runs on the smaller sizes, where it also checks the policy scheduler)
+	cout<<"Engine\t\t\tPolicy\t\t\tProcesses\tSeconds\t\tProcesses/Second\tMatches Reference"<<endl;
+	cout<<"--------------------------------------------------------------------------------------------------------------------"<<endl;
+	
+	for(size_t size = 0; size < bench_sizes.size(); size++)
+	{
+		shared_workload shared;
+		default_workload(shared.workload);
+		shared.workload.seed = seed;
+		shared.workload.arrivals = ARRIVAL_POISSON;
+		shared.workload.load_factor = 0.95;
+		shared.workload.processor_count = 4;
+		shared.workload.deadline_fraction = 0.5;
+		shared.num_processes = max(1.0, bench_sizes[size]);
 		
-		sjf_file<<endl;
+		generate_shared_workload(shared);
 		
-		double avg_waiting_time = 0;
+		vector<ready_job> jobs;
+		build_jobs(shared, mean_arrival_spacing(shared.workload), jobs);
 		
-		avg_waiting_time = total_waiting_time / num_processes;
+		bool run_reference = shared.num_processes <= 20000;
 		
-		sjf_file<<"Average Waiting Time = "<<avg_waiting_time;
+		//Engines 0 - 4 are the policy scheduler running each scheduling policy, 5 is the cluster node engine, and 6 is the reference scheduler
+		for(int engine = 0; engine < 7; engine++)
+		{
+			string engine_name = (engine < 5) ? "policy scheduler" : (engine == 5) ? "cluster node engine" : "reference";
+			scheduling_policy policy = (engine < 5) ? (scheduling_policy)engine : POLICY_SJF;
+			
+			if(engine == 6 && !run_reference)
+			{
+				continue;
+			}
+			
+			vector<schedule_entry> schedule, reference;
+			vector<long long> waiting_times;
+			
+			chrono::steady_clock::time_point start_clock = chrono::steady_clock::now();
+			
+			if(engine < 5)
+			{
+				schedule_jobs(jobs, 4, policy, 0.25, false, schedule);
+			}
+			else if(engine == 5)
+			{
+				cluster_node_schedule(jobs, 4, 1, schedule, waiting_times);
+			}
+			else
+			{
+				reference_schedule(jobs, 4, policy, 0.25, schedule);
+			}
+			
+			double elapsed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start_clock).count();
+			
+			string matches = "-";
+			
+			//Checks the schedules against the reference on the smaller sizes
+			//The cluster node engine is checked against the reference schedule with every arrival 1 cycle later (its dispatch latency)
+			if(run_reference && engine < 6)
+			{
+				vector<ready_job> reference_jobs = jobs;
+				long long wait_offset = (engine == 5) ? 1 : 0;
+				
+				for(size_t i = 0; i < reference_jobs.size(); i++)
+				{
+					reference_jobs[i].arrival_time += wait_offset;
+				}
+				
+				if(engine < 5)
+				{
+					waiting_times = schedule_waiting_times(jobs, schedule);
+				}
+				
+				reference_schedule(reference_jobs, 4, policy, 0.25, reference);
+				
+				bool match = compare_schedules(reference_jobs, reference, schedule, waiting_times, wait_offset) < 0;
+				
+				matches = match ? "yes" : "NO";
+				failures += match ? 0 : 1;
+			}
+			
+			cout<<setw(20)<<left<<engine_name<<"\t"<<setw(16)<<scheduling_policy_name(policy)<<"\t"<<setw(9)<<right<<shared.num_processes<<"\t"
+				<<setw(10)<<fixed<<setprecision(4)<<elapsed_seconds<<"\t"<<setw(16)<<setprecision(0)<<shared.num_processes / max(elapsed_seconds, 1e-9)<<"\t"<<matches<<endl;
+		}
+	}
 	
-		sjf_file.close();
+	return (failures > 0) ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+	option_map options;
+	
+	//Reads the options from the command line (and any config files)
+	if(!parse_options(argc, argv, options))
+	{
+		cout<<"Run with --help to list the options."<<endl;
+		return 1;
+	}
+	
+	if(options.count("help") > 0)
+	{
+		print_usage();
+		return 0;
+	}
+	
+	string mode = option_values(options, "mode", "trace")[0];
+	
+	if(mode != "trace" && mode != "batch" && mode != "cluster" && mode != "timeline" && mode != "energy" && mode != "deadline" && mode != "fuzz")
+	{
+		cout<<"Unknown mode '"<<mode<<"' (use trace, batch, cluster, timeline, energy, deadline, or fuzz)."<<endl;
+		return 1;
+	}
+	
+	warn_unused_options(options, mode);
+	
+	//Runs every combination of option values if in batch mode, or a cluster simulation if in cluster mode
+	if(mode == "batch")
+	{
+		return run_batch(options);
+	}
+	else if(mode == "fuzz")
+	{
+		return run_fuzz(options);
+	}
+	
+	if(!check_single_values(options))
+	{
+		return 1;
+	}
+	
+	if(mode == "cluster")
+	{
+		return run_cluster(options);
+	}
+	else if(mode == "timeline")
+	{
+		return run_timeline(options);
+	}
+	else if(mode == "energy")
+	{
+		return run_energy(options);
+	}
+	else if(mode == "deadline")
+	{
+		return run_deadline(options);
+	}
+	
+	double processes = 0, processors = 0, aging_rate = 0;
+	
+	workload_config workload;
+	
+	//Reads the workload, the number of processes, the number of processors, and the aging rate from the options (defaults are the original settings: 
+	//50 processes with Normal Distribution CPU cycles arriving every 50 cycles, run on 4 processors)
+	if(!read_workload_options(options, "0", workload) || !option_number(options, "processes", "50", processes) ||
+	   !option_number(options, "processors", "4", processors) || !option_number(options, "aging-rate", "0.25", aging_rate))
+	{
+		return 1;
+	}
+	
+	vector<ready_job> trace; //Processes read from the trace file (if there is one)
+	string trace_file = option_values(options, "trace-file", "")[0];
+	
+	//If there is a trace file: Reads the processes from it instead of generating them
+	if(!trace_file.empty())
+	{
+		if(!read_trace_file(trace_file, trace))
+		{
+			return 1;
+		}
 		
-		reset_processes(head, num_processes);
+		if(trace.empty())
+		{
+			cout<<"The trace file '"<<trace_file<<"' has no processes."<<endl;
+			return 1;
+		}
+		
+		processes = trace.size();
 	}
-	else
+	
+	if(processes < 1 || processors < 1 || workload.load_factor < 0 || workload.arrival_spacing < 0)
 	{
-		cout<<"Unable to open the SJF (Shortest Job First) output file for a multi-processor system.";
+		cout<<"Invalid number of processes, number of processors, load factor, or spacing."<<endl;
+		return 1;
 	}
-}
-
-int main()
-{
-	int num_processes = 50, processor_count = 4; //Sets the number of processes to generate to 50
+	
+	output_prefix = option_values(options, "output-prefix", "")[0];
+	
+	int num_processes = processes, processor_count = processors; //Sets the number of processes to generate and the number of processors
 	
 	int quantum = 50, context_switch_penalty = 10; //Sets the quantum to 50 and context switch penalty to 10
 	
+	workload.processor_count = processor_count; //The load factor is measured against the multi-processor system
+	
 	process_list.resize(num_processes); //Resizes the process list to the size that the Doubly Linked List of processes will be
 	
 	node *head = new node; //Declares and initializes the head node pointer of the Doubly Linked List of processes
 	node *tail; //Declares the pointer to the tail of the Doubly Linked List of processes
 	
-	tail = generate_processes(head, num_processes); //Generates the number of processes requested by the user and returns the tail of the Doubly Linked List of processes once after the last process has been generated
+	tail = generate_processes(head, num_processes, workload, trace); //Generates the number of processes requested by the user and returns the tail of the Doubly Linked List of processes once after the last process has been generated
 	
 	//Run the Shortest Job First (SJF) process scheduling algorithm for a single processor system
 	SJF_single_processor(head, num_processes);
@@ -827,9 +3918,31 @@ int main()
 	//Run the Shortest Job First (SJF) process scheduling algorithm for a multi-processor system
 	SJF_multiprocessor(head, num_processes, processor_count);
 	
+	//The burst length range of the workload: the model's bounds, or the shortest and longest processes in the trace file
+	int min_cycles = (workload.bursts == BURST_PARETO) ? workload.pareto_min_cycles : 1000;
+	int max_cycles = (workload.bursts == BURST_PARETO) ? workload.pareto_max_cycles : 11000;
+	
+	if(!trace.empty())
+	{
+		min_cycles = max_cycles = trace[0].CPU_cycles;
+		
+		for(size_t i = 1; i < trace.size(); i++)
+		{
+			min_cycles = min(min_cycles, trace[i].CPU_cycles);
+			max_cycles = max(max_cycles, trace[i].CPU_cycles);
+		}
+	}
+	
+	//Compare SJF against SJF with aging and HRRN (Highest Response Ratio Next) for long process starvation
+	SJF_policy_comparison(num_processes, processor_count, aging_rate, min_cycles, max_cycles);
+	
 	//Deletes the head and tail pointers for the Doubly Linked List of processes before exiting the program
 	delete head;
-	delete tail;
+	
+	if(tail != head)
+	{
+		delete tail;
+	}
 	
 	return 0;
 }
\ No newline at end of file